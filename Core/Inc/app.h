@@ -4,28 +4,118 @@
 #include <stdint.h>
 
 // ======================= 采样参数 =======================
-#define FS_HZ 48000.0f
-#define ADC_BUFFER_SIZE 1024u
-#define FRAME_SAMPLES (ADC_BUFFER_SIZE / 2u)
+// 高采样率模式: 每通道 240kHz(lag 分辨率 5 倍,不靠插值),分析走粗到细 NCC(可在编译选项里覆盖)
+#ifndef AUDIO_HIGH_RATE
+#define AUDIO_HIGH_RATE 0u
+#endif
 
-// 两麦距离
+// 过采样 + 抽取: ADC 以 AUDIO_DECIM_R 倍 FS_HZ 采样,每个半区经 CIC + 补偿 FIR 定点抽取回 FS_HZ(1 = 关闭)
+// 定时器周期 1750/R 须为整数: R 可取 2/5/7/10/14(4/8 倍无整数周期),常用 5 -> ADC 240kHz
+#ifndef AUDIO_DECIM_R
+#define AUDIO_DECIM_R 1u
+#endif
+
+#if AUDIO_HIGH_RATE && (AUDIO_DECIM_R > 1u)
+#error "AUDIO_HIGH_RATE and AUDIO_DECIM_R > 1 are mutually exclusive"
+#endif
+#if (1750u % AUDIO_DECIM_R) != 0u
+#error "AUDIO_DECIM_R must divide 1750"
+#endif
+
+// TIM2 时钟(APB1 x2),TRGO 触发 ADC
+#define TIM2_CLK_HZ 84000000u
+
+#if AUDIO_HIGH_RATE
+#define ADC_TRIG_PERIOD 349u // 84MHz / 350 = 240kHz
+#define FRAME_SAMPLES 1024u  // 4.3ms
+#define MAX_LAG_SAMPLES 84   // 0.12m * 240kHz / 343m/s = 83.97
+#else
+#define ADC_TRIG_PERIOD (1750u / AUDIO_DECIM_R - 1u) // 84MHz / 1750 = 48kHz(过采样时 x R)
+#define FRAME_SAMPLES 512u    // 10.7ms
+#define MAX_LAG_SAMPLES 16    // 0.12m * 48kHz / 343m/s = 16.8
+#endif
+
+// ADC 采样率 / 分析采样率(抽取后)
+#define ADC_FS_HZ ((float)TIM2_CLK_HZ / (float)(ADC_TRIG_PERIOD + 1u))
+#define FS_HZ (ADC_FS_HZ / (float)AUDIO_DECIM_R)
+
+// 抽取输出比 12bit 原始采样多保留的小数位(能量门限随之放大)
+#if AUDIO_DECIM_R > 1u
+#define AUDIO_SAMPLE_FRAC_BITS 3u
+#else
+#define AUDIO_SAMPLE_FRAC_BITS 0u
+#endif
+
+// 帧移(每通道采样数): FRAME_SAMPLES/4 -> 75% 重叠, /2 -> 50%, = FRAME_SAMPLES -> 不重叠
+#define HOP_SAMPLES (FRAME_SAMPLES / 2u)
+
+// DMA 双缓冲: 每半区 HOP_SAMPLES * AUDIO_DECIM_R 个采样对(半传输/传输完成各交出一个半区)
+#define ADC_BUFFER_SIZE (4u * HOP_SAMPLES * AUDIO_DECIM_R)
+
+// 采集方式: 1 = ADC1(CH0) + ADC2(CH1) 双重规则同步(两路同一时刻采样,32bit DMA),
+//           0 = 单 ADC1 扫描 CH0 -> CH1(两路相差一次转换时间)
+#define AUDIO_CAPTURE_DUAL_ADC 1u
+
+// 两麦距离(物理最大延迟 MAX_LAG_SAMPLES 见上,随采样率)
 #define MIC_DIST_M 0.12f
 
-// 物理最大延迟
-#define MAX_LAG_SAMPLES 16
+// 能量门控(按 12bit 采样定标,抽取模式下乘以小数位放大的平方)
+#define ENERGY_TH (60000u << (2u * AUDIO_SAMPLE_FRAC_BITS))
+
+// 置信度门控(低于该值的帧不驱动舵机)
+#define DOA_CONF_TH 0.15f
+
+// 起振门控(优先效应): 起振后 DOA_ONSET_WINDOW_MS 内的帧才做 DOA,之后的混响尾部跳过
+// 起振 = 帧能量超过包络 DOA_ONSET_RATIO 倍;包络峰值保持,按 hop 以 DOA_ONSET_ENV_ALPHA 释放(~100ms)
+#define DOA_ONSET_GATE 1u
+#define DOA_ONSET_WINDOW_MS 40u
+#define DOA_ONSET_RATIO 4.0f
+#if AUDIO_HIGH_RATE
+#define DOA_ONSET_ENV_ALPHA 0.02f
+#else
+#define DOA_ONSET_ENV_ALPHA 0.05f
+#endif
+
+// lag 直方图投票: 每帧衰减系数(~70ms 半衰期),舵机是否跟随直方图主导 lag
+#if AUDIO_HIGH_RATE
+#define DOA_HIST_DECAY 0.98f
+#else
+#define DOA_HIST_DECAY 0.95f
+#endif
+#define DOA_HIST_SERVO 1u
 
-// 能量门控
-#define ENERGY_TH 60000u
+// 多声源: 每帧提取的相关峰数
+#define DOA_TOPK 2u
 
-// 打印间隔
+// 逐采样 NLMS 时延跟踪: 上电是否启用 / 权重峰值门限(低于则不驱动舵机)
+// 采样按 DMA 半区成批送达,舵机仍每 hop 更新一次: 相对块估计没有延迟优势,
+// 好处是开销均摊到每个采样、估计随采样连续收敛(不受分帧边界影响)
+// 高采样率模式下 lag 范围超出 DOA_LMS_MAX_LAG,且逐采样开销过大,不可用
+#define DOA_LMS_TRACK 0u
+#define DOA_LMS_PEAK_TH 0.3f
+
+// 多麦克风阵列引擎(MUSIC / SRP-PHAT): 由 CMake 选项 DOA_ARRAY_ENGINES 编入,
+// 在当前 2 麦上以串口命令开启,打印方位与 DWT 周期(验证目标板实时性)
+#ifndef DOA_ARRAY_ENGINES
+#define DOA_ARRAY_ENGINES 0u
+#endif
+
+// 打印间隔(帧)
+#if AUDIO_HIGH_RATE
+#define PRINT_EVERY_NFRAMES 25u
+#else
 #define PRINT_EVERY_NFRAMES 10u
+#endif
+
+// DOA 截止时间: 单帧 DOA 周期超过 hop 周期的该百分比,连续 N 帧则降级到更便宜的后端
+#define DOA_DEADLINE_PCT 50u
+#define DOA_OVERRUN_FRAMES 3u
 
 // LED
 #define LED_PORT GPIOC
 #define LED_PIN GPIO_PIN_0
 
 // 全局变量声明
-extern volatile uint8_t frame_ready;
 extern volatile uint32_t sample_count_total;
 
 // 应用初始化和主循环
@@ -4,6 +4,28 @@
 #include <stdint.h>
 #include "app.h"
 
+// DMA 半区(乒乓缓冲): 处理方独占 DMA 当前没在写的那一半(抽取模式下为 ADC 采样率下的采样对数)
+#define AUDIO_HALF_PAIRS (HOP_SAMPLES * AUDIO_DECIM_R)
+
+typedef struct
+{
+    const uint32_t *pairs; // AUDIO_HALF_PAIRS 个打包采样对: 低 16 位 ch0, 高 16 位 ch1
+    uint32_t seq;         // 半区序号(每次半传输/传输完成 +1)
+} audio_half_t;
+
+// 采集统计(证明处理跟得上 DMA)
+typedef struct
+{
+    uint32_t seq;       // 最近一帧的序号(= 最新半区序号)
+    uint32_t halves;    // 已处理半区数
+    uint32_t dropped;   // 取之前已被 DMA 覆盖、直接丢弃的半区数
+    uint32_t late;      // 处理期间 DMA 回绕到该半区、作废的半区数
+    uint32_t slack_min; // 取半区时距 DMA 写到该半区的最小余量(ADC 采样对,满分 AUDIO_HALF_PAIRS)
+} audio_stats_t;
+
+// 逐采样回调(去直流前的原始采样,抽取模式下为抽取输出),在 audio_ring_poll 中调用
+typedef void (*audio_sample_hook_t)(int16_t v0, int16_t v1);
+
 // 音频缓冲区
 extern uint16_t adc_buffer[ADC_BUFFER_SIZE];
 extern int16_t mic0[FRAME_SAMPLES];
@@ -14,4 +36,23 @@ void audio_capture_init(void);
 void audio_split_and_remove_dc(const uint16_t *src, int16_t *a, int16_t *b, uint32_t n);
 uint32_t audio_frame_energy(const int16_t *x, uint32_t n);
 
+// 是否有未处理的半区(主循环据此决定是否睡眠)
+uint8_t audio_half_pending(void);
+
+// 取最旧的未处理半区,无则返回 0;落后超过一个半区(已被 DMA 覆盖)时计入丢弃并跳到最新的半区
+uint8_t audio_half_acquire(audio_half_t *half);
+
+// 处理完成后交还;返回 0 表示处理期间 DMA 已回绕到该半区(数据不可信,计入 late)
+uint8_t audio_half_release(const audio_half_t *half);
+
+// 采样环形缓冲: 每个新半区(抽取后 HOP_SAMPLES 个采样)返回 1,之后取最近 FRAME_SAMPLES 个采样做一帧
+uint8_t audio_ring_poll(void);
+void audio_ring_frame(int16_t *a, int16_t *b, uint32_t *e0, uint32_t *e1);
+
+// 设置逐采样回调(NULL 关闭)
+void audio_set_sample_hook(audio_sample_hook_t hook);
+
+// 读取采集统计;restart_slack 非 0 时 slack_min 重新统计(按打印周期取最小值)
+void audio_get_stats(audio_stats_t *st, uint8_t restart_slack);
+
 #endif /* __AUDIO_CAPTURE_H */
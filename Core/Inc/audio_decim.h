@@ -0,0 +1,26 @@
+#ifndef __AUDIO_DECIM_H
+#define __AUDIO_DECIM_H
+
+#include <stdint.h>
+#include "app.h"
+
+// CIC 级数 / 补偿 FIR 阶数(奇数,对称)
+#define AUDIO_DECIM_STAGES 4u
+#define AUDIO_DECIM_TAPS 15u
+
+// 12bit 中点(输入先减去,积分器只累加交流分量)
+#define AUDIO_DECIM_MID 2048
+
+// FIR 系数定标(含 CIC 增益 R^N 归一与 AUDIO_SAMPLE_FRAC_BITS 放大)
+#define AUDIO_DECIM_COEF_SHIFT 30
+
+// 每输入采样对的周期预算(Cortex-M4 估算,含两路 CIC 积分 + 摊到每对的梳状/FIR)
+#define AUDIO_DECIM_CYC_PER_PAIR 40u
+
+// 生成定点 FIR 系数并清零滤波器状态
+void audio_decim_init(void);
+
+// 抽取一个半区: n 个打包采样对(低 16 位 ch0) -> n / AUDIO_DECIM_R 个输出,返回输出点数
+uint32_t audio_decim_half(const uint32_t *pairs, uint32_t n, int16_t *out0, int16_t *out1);
+
+#endif /* __AUDIO_DECIM_H */
@@ -2,8 +2,77 @@
 #define __DOA_H
 
 #include <stdint.h>
+#include "doa_peak.h"
+
+// DOA 后端编号(与 doa.c 中的后端表顺序一致)
+#define DOA_BACKEND_NCC 0u
+#define DOA_BACKEND_NCC_C2F 1u
+#define DOA_BACKEND_GCC_PHAT 2u
+#define DOA_BACKEND_GCC_PHAT_AVG 3u
+#define DOA_BACKEND_NCC_Q 4u
+
+// 上电默认后端(可在编译选项里覆盖)
+#ifndef DOA_DEFAULT_BACKEND
+#define DOA_DEFAULT_BACKEND DOA_BACKEND_NCC
+#endif
+
+// 峰旁瓣比上限(无次峰时取该值)
+#define DOA_PSR_MAX 100.0f
+
+// DOA 单帧结果
+typedef struct
+{
+  int32_t lag;      // 整数峰 lag
+  int32_t lag_q16;  // 插值后 lag(Q16.16)
+  float peak;       // 峰值相关
+  float second;     // 次峰(最大旁瓣)相关
+  float psr;        // 峰旁瓣比 peak / second
+  float confidence; // 归一化置信度 [0, 1]
+} doa_result_t;
+
+// DOA 后端描述
+typedef struct
+{
+  const char *name;                                                                          // 名称(串口命令用)
+  void (*init)(void);                                                                        // 切换到该后端时调用,可为 NULL
+  void (*corr)(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr); // 相关函数
+  uint32_t scratch_bytes;                                                                    // 静态工作区大小
+  uint32_t cycles;                                                                           // 每帧周期初始估算(512 点, +-16 lag, 168MHz M4),实测后以 doa_backend_cycles 为准
+} doa_backend_t;
+
+// 初始化(选中 DOA_DEFAULT_BACKEND)
+void doa_init(void);
+
+// 后端查询/切换,编号或名称非法返回 -1
+uint32_t doa_backend_count(void);
+const doa_backend_t *doa_backend_get(uint32_t id);
+uint32_t doa_backend_current(void);
+int doa_backend_select(uint32_t id);
+int doa_backend_select_by_name(const char *name);
+
+// 记录当前后端一帧的实测周期(DWT),按 1/8 指数平均
+void doa_backend_record_cycles(uint32_t cycles);
+
+// 后端每帧实测周期(平均),尚未运行过返回 0
+uint32_t doa_backend_measured_cycles(uint32_t id);
+
+// 超时降级: 切到周期更低的后端中最贵的一个,已是最便宜时返回 -1
+int doa_backend_fallback(void);
+
+// DOA 估计(完整结果: lag / 峰值 / 峰旁瓣比 / 置信度)
+void doa_estimate(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, doa_result_t *res);
+
+// 多声源: Top-K 相关峰(按 score 降序,返回峰数)
+uint32_t doa_estimate_topk(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag,
+                           doa_peak_t *peaks, uint32_t k);
+
+// 多声源: 复用上一次估计留下的相关函数提取 Top-K,不重新计算
+uint32_t doa_last_topk(doa_peak_t *peaks, uint32_t k);
 
 // DOA 估计接口
 int32_t doa_estimate_lag(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag);
 
+// DOA 估计接口(峰值插值,返回 Q16.16 亚采样 lag)
+int32_t doa_estimate_lag_q16(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag);
+
 #endif /* __DOA_H */
@@ -0,0 +1,22 @@
+#ifndef __DOA_ANGLE_H
+#define __DOA_ANGLE_H
+
+#include <stdint.h>
+#include "app.h"
+
+// 查表范围(采样)与分辨率(每采样的分段数,2 的幂)
+#define DOA_ANGLE_MAX_LAG MAX_LAG_SAMPLES
+#define DOA_ANGLE_STEPS_SHIFT 4
+#define DOA_ANGLE_STEPS (1 << DOA_ANGLE_STEPS_SHIFT)
+#define DOA_ANGLE_TAB_LEN (2 * DOA_ANGLE_MAX_LAG * DOA_ANGLE_STEPS + 1)
+
+// 生成 lag -> 方位角表: 表由 FS_HZ(随 AUDIO_HIGH_RATE / AUDIO_DECIM_R)/ MIC_DIST_M / SOUND_SPEED_MPS 决定,
+// 上电用 asinf 算一次(不手写 const 表,改配置时不会过期);app_init 里调用,
+// 未调用时 doa_angle_from_lag_q16 首次使用自动生成
+void doa_angle_init(void);
+
+// 亚采样 lag(Q16.16) -> 方位角(0.01 度),从阵列正前方向 mic1 一侧为正
+// 查表 + 线性插值,运行时不做三角函数;超出 +-DOA_ANGLE_MAX_LAG 时饱和到表端(超出声速极限的部分为 +-90 度)
+int32_t doa_angle_from_lag_q16(int32_t lag_q16);
+
+#endif /* __DOA_ANGLE_H */
@@ -0,0 +1,39 @@
+#ifndef __DOA_ARRAY_H
+#define __DOA_ARRAY_H
+
+#include <stdint.h>
+#include "app.h"
+
+// 声速
+#define SOUND_SPEED_MPS 343.0f
+
+// 阵列最大麦克风数
+#define DOA_ARRAY_MAX_MICS 4u
+
+// 麦克风坐标(米),阵列平面内
+typedef struct
+{
+  float x_m;
+  float y_m;
+} doa_mic_pos_t;
+
+// 阵列几何表
+typedef struct
+{
+  uint8_t num_mics;
+  doa_mic_pos_t pos[DOA_ARRAY_MAX_MICS];
+} doa_array_t;
+
+// 当前硬件: mic0/mic1 沿 x 轴,间距 MIC_DIST_M,原点在中点
+#define DOA_ARRAY_INIT_2MIC {2u, {{-0.5f * MIC_DIST_M, 0.0f}, {0.5f * MIC_DIST_M, 0.0f}}}
+
+/**
+ * @brief 平面波到达第 m 个麦克风相对原点的时延(秒)
+ * 方位角 az 从 +y(阵列正前方)向 +x 计,传入 sin(az)/cos(az)
+ */
+static inline float doa_array_delay_s(const doa_array_t *arr, uint32_t m, float sin_az, float cos_az)
+{
+  return -(arr->pos[m].x_m * sin_az + arr->pos[m].y_m * cos_az) / SOUND_SPEED_MPS;
+}
+
+#endif /* __DOA_ARRAY_H */
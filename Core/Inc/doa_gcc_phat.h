@@ -2,8 +2,58 @@
 #define __DOA_GCC_PHAT_H
 
 #include <stdint.h>
+#include "dsp_fft.h"
 
-// GCC-PHAT 估计 lag (预留接口)
+// 静态工作区(字节): 两路频谱 / 另加帧间平均互谱与自谱
+#define GCC_SCRATCH_BYTES (2u * FFT_MAX_N * sizeof(float))
+#define GCC_AVG_SCRATCH_BYTES (4u * FFT_MAX_N * sizeof(float))
+
+// 帧间互功率谱平均的默认遗忘因子
+#define GCC_AVG_FORGET 0.8f
+
+// 广义互相关频域加权
+#define GCC_W_PHAT 0u      // 1/|G|,抗混响
+#define GCC_W_SCOT 1u      // 1/sqrt(Gxx*Gyy),两路噪声不同时
+#define GCC_W_ROTH 2u      // 1/Gxx,抑制 x 路噪声强的频段
+#define GCC_W_PHAT_BETA 3u // 1/|G|^beta,介于互相关与 PHAT 之间
+#define GCC_W_ML 4u        // Hannan-Thomson 最大似然(需帧间平均)
+#define GCC_W_COUNT 5u
+
+// SCOT / ML 需要帧间平均的自/互功率谱: 单帧时 Pxx*Pyy = |G|^2,SCOT 退化为 PHAT,ML 为常数倍 PHAT,
+// 只在 gcc_phat_avg 后端上有区别(串口 gccw 选中它们时自动切到该后端)
+#define GCC_W_NEEDS_AVG(w) ((w) == GCC_W_SCOT || (w) == GCC_W_ML)
+
+// PHAT-beta 默认指数
+#define GCC_PHAT_BETA 0.7f
+
+// ML 加权相干函数上限(防止 1/(1-gamma^2) 发散)
+#define GCC_ML_COH_MAX 0.99f
+
+// GCC 广义互相关估计 lag(默认 PHAT 加权,可用 doa_gcc_set_weighting 切换)
 int32_t doa_estimate_lag_gcc_phat(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag);
 
+// GCC 相关函数(corr 长度 2*max_lag+1,供插值/多峰使用)
+void doa_gcc_phat_corr(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr);
+
+// PHAT 加权互功率谱(频域打包格式,r 可与 xf 相同)
+void gcc_phat_cross(const float *xf, const float *yf, float *r, uint32_t nfft);
+
+// 相位斜率法: 互谱相位解缠 + 加权最小二乘斜率(只用空间混叠频率以下的频点,无逆变换)
+int gcc_phase_slope(const float *xf, const float *yf, uint32_t nfft, uint32_t k_max, float *lag, float *fit);
+
+// 相位斜率模式: 开启后 GCC 相关函数顺带用本帧频谱求斜率,doa_estimate 取走后替换插值 lag
+void doa_gcc_set_phase_slope(uint8_t on);
+uint8_t doa_gcc_get_phase_slope(void);
+int doa_gcc_take_slope(int32_t *lag_q16, float *fit);
+
+// 帧间递推平均互功率谱/自功率谱后再加权(低信噪比下更稳)
+int32_t doa_estimate_lag_gcc_phat_avg(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag);
+void doa_gcc_phat_avg_corr(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr);
+void doa_gcc_avg_set_forget(float forget);
+void doa_gcc_avg_reset(void);
+
+// 运行时切换加权方式(两条 GCC 路径共用,不增加内存/变换次数)
+int doa_gcc_set_weighting(uint8_t weighting, float beta);
+uint8_t doa_gcc_get_weighting(void);
+
 #endif /* __DOA_GCC_PHAT_H */
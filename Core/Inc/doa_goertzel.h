@@ -0,0 +1,19 @@
+#ifndef __DOA_GOERTZEL_H
+#define __DOA_GOERTZEL_H
+
+#include <stdint.h>
+
+// 已知频率信标的最大音调数
+#define DOA_GOERTZEL_MAX_TONES 4u
+
+// 配置音调(Hz),n_tones = 0 表示关闭;频率非法返回 -1
+int doa_goertzel_init(const float *freq_hz, uint32_t n_tones, float fs_hz);
+
+// 当前音调数
+uint32_t doa_goertzel_tones(void);
+
+// 单帧估计: 每个音调两路各一个 Goertzel 滤波器,由互谱相位差得到 lag(Q16.16,限幅到 +-max_lag)
+// 返回音调纯度 [0, 1](音调能量占帧能量的比例,多音调取合计),无有效音调时返回 0
+float doa_goertzel_estimate(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, int32_t *lag_q16);
+
+#endif /* __DOA_GOERTZEL_H */
@@ -0,0 +1,24 @@
+#ifndef __DOA_HIST_H
+#define __DOA_HIST_H
+
+#include <stdint.h>
+
+// 直方图范围(采样,覆盖高采样率模式)与分辨率(每采样的格数)
+#define DOA_HIST_MAX_LAG 96
+#define DOA_HIST_RES 4
+#define DOA_HIST_BINS (2 * DOA_HIST_MAX_LAG * DOA_HIST_RES + 1)
+
+// 初始化: max_lag <= DOA_HIST_MAX_LAG, decay = 每帧衰减系数 (0, 1)
+int doa_hist_init(int32_t max_lag, float decay);
+void doa_hist_reset(void);
+
+// 每帧一次(含无声帧): 衰减所有格(惰性,O(1)),再把 lag(Q16.16)按权重线性分到相邻两格;weight <= 0 只衰减
+void doa_hist_update(int32_t lag_q16, float weight);
+
+// 主导 lag(众数格 + 三点插值,Q16.16);无数据时返回 0
+int32_t doa_hist_mode_q16(void);
+
+// 众数格权重占总权重的比例 [0, 1](越大越集中)
+float doa_hist_strength(void);
+
+#endif /* __DOA_HIST_H */
@@ -0,0 +1,31 @@
+#ifndef __DOA_LMS_H
+#define __DOA_LMS_H
+
+#include <stdint.h>
+
+// 自适应时延估计: 最大 lag(抽头数 2*max_lag+1)
+#define DOA_LMS_MAX_LAG 32
+
+// 默认步长(NLMS, 0 < mu < 2)
+#define DOA_LMS_MU 0.05f
+
+// 去直流一阶高通的时间常数(2^N 个采样)
+#define DOA_LMS_DC_SHIFT 10
+
+// 初始化/复位,参数非法返回 -1
+int doa_lms_init(int32_t max_lag, float mu);
+void doa_lms_reset(void);
+
+// 逐采样更新(原始 ADC 采样,内部去直流),每采样固定 O(max_lag) 开销
+void doa_lms_push(int16_t x, int16_t y);
+
+// 抽头权重峰值对应的 lag(Q16.16,符号同 doa_estimate_lag: y[i + lag] ~ x[i])
+int32_t doa_lms_lag_q16(void);
+
+// 峰值权重(未收敛时接近 0)
+float doa_lms_peak(void);
+
+// 抽头权重(按 corr[lag + max_lag] 约定排列)
+const float *doa_lms_weights(void);
+
+#endif /* __DOA_LMS_H */
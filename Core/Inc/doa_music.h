@@ -0,0 +1,41 @@
+#ifndef __DOA_MUSIC_H
+#define __DOA_MUSIC_H
+
+#include <stdint.h>
+#include "doa_array.h"
+
+// MUSIC 资源上限
+#define MUSIC_MAX_MICS DOA_ARRAY_MAX_MICS
+#define MUSIC_MAX_BINS 16u
+#define MUSIC_MAX_GRID 73u
+#define MUSIC_MAX_NFFT 1024u // 一帧不补零,高采样率也只需 1024 点
+
+// MUSIC 配置
+typedef struct
+{
+  const doa_array_t *array; // 阵列几何
+  float fs_hz;              // 采样率
+  uint32_t nfft;            // 每帧 FFT 点数(2 的幂, <= MUSIC_MAX_NFFT)
+  float f_lo_hz;            // 宽带频段下限
+  float f_hi_hz;            // 宽带频段上限
+  uint8_t num_bins;         // 使用的频点数(1 = 窄带,取 f_lo_hz)
+  uint8_t num_sources;      // 信号源数(< num_mics)
+  float forget;             // 协方差遗忘因子 (0,1],越大越平滑
+  float az_start_deg;       // 扫描起始方位角
+  float az_step_deg;        // 扫描步长
+  uint16_t grid_n;          // 扫描点数(<= MUSIC_MAX_GRID)
+} doa_music_cfg_t;
+
+// 初始化(预计算频点、导向矢量与逐频点旋转因子),参数非法返回 -1
+int doa_music_init(const doa_music_cfg_t *cfg);
+
+// 每帧调用: 各通道 FFT + 协方差递推更新,ch[m] 指向第 m 路 n 个采样
+void doa_music_update(const int16_t *const ch[], uint32_t n);
+
+// 特征分解 + 方位扫描,返回伪谱峰值方位角(度)
+float doa_music_estimate(void);
+
+// 最近一次扫描的伪谱(grid_n 个点)
+const float *doa_music_spectrum(void);
+
+#endif /* __DOA_MUSIC_H */
@@ -3,7 +3,36 @@
 
 #include <stdint.h>
 
+// 粗到细搜索参数: 抽取倍数 / 细搜索半径 / 支持的最大帧长
+#define NCC_C2F_DECIM 4u
+#define NCC_C2F_REFINE 3
+#define NCC_C2F_MAX_N 1024u
+
+// 细搜索的粗峰个数: 覆盖多峰提取的 DOA_TOPK 个声源,再多精算一个旁瓣,峰旁瓣比/置信度才有意义
+#ifndef NCC_C2F_PEAKS
+#define NCC_C2F_PEAKS 3u
+#endif
+
+// 粗到细搜索的静态工作区(字节)
+#define NCC_C2F_SCRATCH_BYTES (2u * (NCC_C2F_MAX_N / 2u) * sizeof(int16_t))
+
 // NCC 归一化互相关估计 lag
 int32_t doa_estimate_lag_ncc(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag);
 
+// NCC 相关函数(corr 长度 2*max_lag+1,供插值/多峰使用)
+void doa_ncc_corr(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr);
+
+// 定点 NCC: 交叉相乘比较平方得分(保留符号),lag 循环内无开方/除法,与 doa_estimate_lag_ncc 选同一峰
+int32_t doa_estimate_lag_ncc_q(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag);
+
+// 定点 NCC 相关函数: 定点比较找局部极大,只在极大及其邻点归一化,其余 lag 为 DOA_CORR_INVALID
+void doa_ncc_corr_q(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr);
+
+// 定点 NCC 的静态工作区(字节)
+#define NCC_Q_SCRATCH_BYTES (DOA_CORR_MAX_LEN * (sizeof(int64_t) + 2u * sizeof(uint64_t)))
+
+// 粗到细 NCC: /4 抽取粗搜索 + 前 NCC_C2F_PEAKS 个粗峰附近全速率精算
+int32_t doa_estimate_lag_ncc_c2f(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag);
+void doa_ncc_corr_c2f(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr);
+
 #endif /* __DOA_NCC_H */
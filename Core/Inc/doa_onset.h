@@ -0,0 +1,17 @@
+#ifndef __DOA_ONSET_H
+#define __DOA_ONSET_H
+
+#include <stdint.h>
+
+// 帧分类
+#define DOA_ONSET_IDLE 0u   // 能量低于门限
+#define DOA_ONSET_DIRECT 1u // 起振后窗口内(直达声为主)
+#define DOA_ONSET_TAIL 2u   // 窗口之后(混响尾部为主)
+
+// 初始化: window_frames = 起振后允许估计的帧数, ratio = 起振判定的能量跳变倍数, alpha = 包络释放系数
+void doa_onset_init(uint32_t window_frames, float ratio, float alpha);
+
+// 每帧输入能量(均方),返回 DOA_ONSET_*;th 为绝对能量门限
+uint8_t doa_onset_update(uint32_t energy, uint32_t th);
+
+#endif /* __DOA_ONSET_H */
@@ -0,0 +1,50 @@
+#ifndef __DOA_PEAK_H
+#define __DOA_PEAK_H
+
+#include <stdint.h>
+
+// 相关函数缓冲区约定: corr[lag + max_lag], 共 2*max_lag+1 个点
+// 无效点(重叠区能量为 0)填 DOA_CORR_INVALID
+#define DOA_CORR_INVALID (-1e9f)
+
+// Q16.16 亚采样 lag 的 1.0
+#define DOA_Q16_ONE 65536
+
+// 相关缓冲区支持的最大 lag
+#define DOA_CORR_MAX_LAG 128
+#define DOA_CORR_MAX_LEN (2 * DOA_CORR_MAX_LAG + 1)
+
+// 插值方式
+#define DOA_INTERP_PARABOLIC 0
+#define DOA_INTERP_GAUSSIAN 1
+
+#ifndef DOA_PEAK_INTERP
+#define DOA_PEAK_INTERP DOA_INTERP_PARABOLIC
+#endif
+
+// 多峰提取的最小间隔(lag),间隔内只保留较强的峰
+#ifndef DOA_TOPK_MIN_SEP
+#define DOA_TOPK_MIN_SEP 3
+#endif
+
+// 单个相关峰
+typedef struct
+{
+  int32_t lag;     // 整数 lag
+  int32_t lag_q16; // 插值后 lag(Q16.16)
+  float score;     // 峰值相关
+} doa_peak_t;
+
+// 相关峰位置(整数 lag),全部无效时返回 0
+int32_t doa_corr_argmax(const float *corr, int32_t max_lag);
+
+// 单次扫描同时找主峰和次峰(局部极大,不含主峰本身),全部无效时 peak = DOA_CORR_INVALID
+void doa_corr_peaks(const float *corr, int32_t max_lag, int32_t *peak_lag, float *peak, float *second);
+
+// 峰附近三点插值,返回亚采样偏移 [-0.5, 0.5]
+float doa_corr_interp(const float *corr, int32_t max_lag, int32_t lag);
+
+// Top-K 多峰提取(局部极大 + 非极大值抑制),按 score 降序,返回实际峰数
+uint32_t doa_corr_topk(const float *corr, int32_t max_lag, uint32_t k, int32_t min_sep, doa_peak_t *out);
+
+#endif /* __DOA_PEAK_H */
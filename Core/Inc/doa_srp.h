@@ -0,0 +1,34 @@
+#ifndef __DOA_SRP_H
+#define __DOA_SRP_H
+
+#include <stdint.h>
+#include "doa_array.h"
+
+// SRP-PHAT 资源上限
+#define SRP_MAX_MICS DOA_ARRAY_MAX_MICS
+#define SRP_MAX_PAIRS ((SRP_MAX_MICS * (SRP_MAX_MICS - 1u)) / 2u)
+#define SRP_MAX_GRID 72u
+#define SRP_MAX_LAG 64
+#define SRP_MAX_NFFT 1024u // 缓冲不随高采样率的 FFT_MAX_N 加倍(+-84 lag 已超出 SRP_MAX_LAG)
+
+// SRP-PHAT 配置
+typedef struct
+{
+  const doa_array_t *array; // 阵列几何
+  float fs_hz;              // 采样率
+  uint32_t nfft;            // FFT 点数(>= 帧长 + 最大 lag,<= SRP_MAX_NFFT)
+  float az_start_deg;       // 扫描起始方位角
+  float az_step_deg;        // 扫描步长
+  uint16_t grid_n;          // 扫描点数(<= SRP_MAX_GRID)
+} doa_srp_cfg_t;
+
+// 初始化: 预计算 方位网格 -> 各麦克风对 lag 查找表,参数非法返回 -1
+int doa_srp_init(const doa_srp_cfg_t *cfg);
+
+// 每帧: N 路 FFT + 各对 GCC-PHAT + 查表累加,返回功率最大方位角(度)
+float doa_srp_estimate(const int16_t *const ch[], uint32_t n);
+
+// 最近一次的导向响应功率(grid_n 个点)
+const float *doa_srp_power(void);
+
+#endif /* __DOA_SRP_H */
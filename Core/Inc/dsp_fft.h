@@ -0,0 +1,27 @@
+#ifndef __DSP_FFT_H
+#define __DSP_FFT_H
+
+#include <stdint.h>
+#include "app.h"
+
+// 支持的最大 FFT 点数(2 的幂),须容纳一帧补零到 FRAME_SAMPLES + MAX_LAG_SAMPLES:
+// 高采样率 1024 + 84 需要 2048 点(旋转因子表与 GCC / SRP 缓冲随之加倍)
+#if AUDIO_HIGH_RATE
+#define FFT_MAX_N 2048u
+#else
+#define FFT_MAX_N 1024u
+#endif
+
+#if (FRAME_SAMPLES + MAX_LAG_SAMPLES) > FFT_MAX_N
+#error "FFT_MAX_N too small for FRAME_SAMPLES + MAX_LAG_SAMPLES (GCC would truncate frames)"
+#endif
+
+// 实数 FFT(float, radix-2),原地运算
+// 打包格式: buf[0]=Re X[0], buf[1]=Re X[N/2], buf[2k]=Re X[k], buf[2k+1]=Im X[k] (1<=k<N/2)
+void fft_real_forward(float *buf, uint32_t n);
+void fft_real_inverse(float *buf, uint32_t n);
+
+// 不小于 n 的 2 的幂,超过 FFT_MAX_N 返回 0
+uint32_t fft_size_for(uint32_t n);
+
+#endif /* __DSP_FFT_H */
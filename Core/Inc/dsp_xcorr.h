@@ -0,0 +1,16 @@
+#ifndef __DSP_XCORR_H
+#define __DSP_XCORR_H
+
+#include <stdint.h>
+
+// 16bit 点积 sum(a[i] * b[i]),64bit 累加
+// Cortex-M4(__ARM_FEATURE_DSP)下使用 SMLALD 双 MAC,其余平台为纯 C 实现
+int64_t dsp_dot_q15(const int16_t *a, const int16_t *b, uint32_t len);
+
+// 16bit 能量 sum(a[i]^2)
+uint64_t dsp_energy_q15(const int16_t *a, uint32_t len);
+
+// 纯 C 参考实现(主机/校验用,结果与 dsp_dot_q15 逐位一致)
+int64_t dsp_dot_q15_ref(const int16_t *a, const int16_t *b, uint32_t len);
+
+#endif /* __DSP_XCORR_H */
@@ -9,11 +9,11 @@
 #define SERVO_US_MAX 2500
 #define SERVO_US_CENTER ((SERVO_US_MIN + SERVO_US_MAX) / 2)
 
-// 满量程增益映射
-#define SERVO_K_US_PER_LAG (((float)(SERVO_US_MAX - SERVO_US_MIN)) / (2.0f * (float)MAX_LAG_SAMPLES))
+// 角度映射: 满量程对应 +-90 度
+#define SERVO_US_PER_DEG (((float)(SERVO_US_MAX - SERVO_US_MIN)) / 180.0f)
 
-// 死区
-#define LAG_DEADBAND 1
+// 死区(Q16.16 lag): 1/4 采样,只滤掉正前方的插值抖动,不吃掉亚采样分辨率
+#define LAG_DEADBAND_Q16 (65536 / 4)
 
 // 一阶滤波系数
 #define SERVO_ALPHA 0.15f
@@ -22,6 +22,8 @@
 void servo_init(void);
 void servo_write_us(int us);
 void servo_track_from_lag(int32_t lag, uint8_t valid);
+void servo_track_from_lag_q16(int32_t lag_q16, uint8_t valid);
+void servo_track_from_angle(int32_t angle_cdeg, uint8_t valid);
 int servo_get_current_us(void);
 
 #endif /* __SERVO_H */
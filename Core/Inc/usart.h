@@ -41,6 +41,16 @@ extern UART_HandleTypeDef huart1;
 void MX_USART1_UART_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+// 串口命令行(中断接收,按行返回)
+#define UART_CMD_MAX 32u
+void uart_cmd_start(void);
+uint8_t uart_cmd_poll(char *line, uint32_t size);
+
+// printf 发送环形缓冲(中断发送,不阻塞主循环),满时整段丢弃
+#ifndef UART_TX_BUF_SIZE
+#define UART_TX_BUF_SIZE 2048u
+#endif
+uint32_t uart_tx_dropped(void);
 
 /* USER CODE END Prototypes */
 
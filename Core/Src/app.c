@@ -1,29 +1,367 @@
 #include "app.h"
 #include "audio_capture.h"
+#include "audio_decim.h"
 #include "doa.h"
+#include "doa_angle.h"
+#include "doa_gcc_phat.h"
+#include "doa_goertzel.h"
+#include "doa_hist.h"
+#include "doa_lms.h"
+#include "doa_ncc.h"
+#if DOA_ARRAY_ENGINES
+#include "doa_music.h"
+#include "doa_srp.h"
+#include "dsp_fft.h"
+#endif
+#include "doa_onset.h"
 #include "servo.h"
 #include "gpio.h"
 #include "usart.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 粗到细 NCC 只精算前 NCC_C2F_PEAKS 个粗峰,其余 lag 无效: 须覆盖 DOA_TOPK 个声源外加一个旁瓣
+#if DOA_TOPK >= NCC_C2F_PEAKS
+#error "NCC_C2F_PEAKS must exceed DOA_TOPK"
+#endif
 
 // 静态变量
 static uint32_t last_tick_ms = 0;
 static uint32_t frame_cnt = 0;
 
+// DOA 截止时间(周期)与连续超时计数
+static uint32_t doa_budget_cycles = 0;
+static uint32_t doa_overrun_cnt = 0;
+static uint32_t doa_last_cycles = 0;
+
+// 最近一次取半区 + 入环(含抽取)的周期
+static uint32_t cap_last_cycles = 0;
+
+// 低置信度跳过的帧数 / 混响尾部跳过的帧数
+static uint32_t low_conf_cnt = 0;
+static uint32_t tail_skip_cnt = 0;
+
+// 逐采样 NLMS 跟踪开关(lms_ok: 当前 lag 范围可用),以及最近一帧的能量/起振门控结果
+static uint8_t lms_ok = 0;
+static uint8_t lms_track = DOA_LMS_TRACK;
+static uint8_t frame_active = 0;
+
+// 舵机最近一次更新时已处理的半区数(每个新半区至多更新一次)
+static uint32_t servo_halves = 0;
+
+#if DOA_ARRAY_ENGINES
+// 阵列引擎(当前硬件 2 麦): 开关与最近一次方位/周期
+static const doa_array_t app_array = DOA_ARRAY_INIT_2MIC;
+static uint8_t music_on = 0;
+static float music_az = 0.0f;
+static uint32_t music_cycles = 0;
+static uint8_t srp_on = 0;
+static float srp_az = 0.0f;
+static uint32_t srp_cycles = 0;
+#endif
+
+/**
+ * @brief 打印后端列表
+ */
+static void app_print_backends(void)
+{
+    for (uint32_t i = 0; i < doa_backend_count(); i++)
+    {
+        const doa_backend_t *b = doa_backend_get(i);
+        printf("  %c %-13s scratch=%luB  est=%lucyc meas=%lucyc\r\n",
+               (i == doa_backend_current()) ? '*' : ' ', b->name,
+               (unsigned long)b->scratch_bytes, (unsigned long)b->cycles,
+               (unsigned long)doa_backend_measured_cycles(i));
+    }
+}
+
+// GCC 加权名称(顺序与 GCC_W_* 一致)
+static const char *const gcc_weighting_names[GCC_W_COUNT] = {"phat", "scot", "roth", "beta", "ml"};
+
+/**
+ * @brief 串口命令: "gccw <phat|scot|roth|beta|ml> [beta]" 切换 GCC 加权
+ */
+static void app_handle_gccw(const char *arg)
+{
+    for (uint32_t w = 0; w < GCC_W_COUNT; w++)
+    {
+        size_t len = strlen(gcc_weighting_names[w]);
+        if (strncmp(arg, gcc_weighting_names[w], len) == 0 && (arg[len] == '\0' || arg[len] == ' '))
+        {
+            float beta = (arg[len] == ' ') ? strtof(arg + len + 1, NULL) : 0.0f;
+            (void)doa_gcc_set_weighting((uint8_t)w, beta);
+            doa_gcc_avg_reset();
+            printf("[DOA] gcc weighting -> %s\r\n", gcc_weighting_names[w]);
+
+            // 单帧谱上 SCOT/ML 与 PHAT 无区别,切到帧间平均后端才生效
+            if (GCC_W_NEEDS_AVG(w) && doa_backend_current() != DOA_BACKEND_GCC_PHAT_AVG)
+            {
+                (void)doa_backend_select(DOA_BACKEND_GCC_PHAT_AVG);
+                doa_overrun_cnt = 0;
+                printf("[DOA] %s needs averaged spectra, backend -> %s\r\n", gcc_weighting_names[w],
+                       doa_backend_get(DOA_BACKEND_GCC_PHAT_AVG)->name);
+            }
+            return;
+        }
+    }
+    printf("[DOA] unknown weighting '%s'\r\n", arg);
+}
+
+/**
+ * @brief 逐采样 NLMS 跟踪开关
+ */
+static void app_set_lms_track(uint8_t on)
+{
+    lms_track = on && lms_ok;
+    doa_lms_reset();
+    audio_set_sample_hook(lms_track ? doa_lms_push : NULL);
+}
+
+/**
+ * @brief 舵机更新(唯一入口): 每个新半区至多一次;NLMS 跟踪时 lag/有效性取 NLMS 结果
+ * 采样按 DMA 半区成批送达,NLMS 也只在半区边界上推进,故舵机节拍与块估计相同(每 hop 一次)
+ */
+static void app_servo_update(int32_t *lag_q16, uint8_t *valid)
+{
+    audio_stats_t st;
+    audio_get_stats(&st, 0);
+    if (st.halves == servo_halves)
+        return;
+    servo_halves = st.halves;
+
+    if (lms_track)
+    {
+        *lag_q16 = doa_lms_lag_q16();
+        *valid = frame_active && (doa_lms_peak() > DOA_LMS_PEAK_TH);
+    }
+    servo_track_from_lag_q16(*lag_q16, *valid);
+}
+
+/**
+ * @brief 串口命令: "beacon <f1> [f2 ...]" 已知音调信标模式, "beacon off" 关闭
+ */
+static void app_handle_beacon(const char *arg)
+{
+    float freq[DOA_GOERTZEL_MAX_TONES];
+    uint32_t n = 0;
+
+    if (strcmp(arg, "off") != 0)
+    {
+        char *end;
+        float f = strtof(arg, &end);
+        while (end != arg && n < DOA_GOERTZEL_MAX_TONES)
+        {
+            freq[n++] = f;
+            arg = end;
+            f = strtof(arg, &end);
+        }
+        if (n == 0u)
+        {
+            printf("[DOA] beacon: no frequency\r\n");
+            return;
+        }
+    }
+
+    if (doa_goertzel_init(freq, n, FS_HZ) != 0)
+    {
+        printf("[DOA] beacon: bad frequency\r\n");
+        return;
+    }
+    doa_hist_reset();
+    printf("[DOA] beacon tones=%lu\r\n", (unsigned long)n);
+}
+
+#if DOA_ARRAY_ENGINES
+/**
+ * @brief MUSIC 初始化: 2 麦线阵,-90..90 度 / 2.5 度,宽带取空间混叠频率以下 8 个频点
+ */
+static void app_music_init(void)
+{
+    doa_music_cfg_t cfg = {0};
+    cfg.array = &app_array;
+    cfg.fs_hz = FS_HZ;
+    cfg.nfft = FRAME_SAMPLES;
+    cfg.f_lo_hz = 500.0f;
+    cfg.f_hi_hz = 0.95f * SOUND_SPEED_MPS / (2.0f * MIC_DIST_M);
+    cfg.num_bins = 8u;
+    cfg.num_sources = 1u;
+    cfg.forget = 0.7f;
+    cfg.az_start_deg = -90.0f;
+    cfg.az_step_deg = 2.5f;
+    cfg.grid_n = 73u;
+
+    if (doa_music_init(&cfg) != 0)
+    {
+        printf("[DOA] music init failed\r\n");
+    }
+}
+
+/**
+ * @brief SRP-PHAT 初始化: 2 麦线阵,-88.75..88.75 度 / 2.5 度,补零到帧长 + 最大 lag
+ * 返回 0 成功(高采样率下 lag 超出 SRP_MAX_LAG 时失败)
+ */
+static int app_srp_init(void)
+{
+    doa_srp_cfg_t cfg = {0};
+    cfg.array = &app_array;
+    cfg.fs_hz = FS_HZ;
+    cfg.nfft = fft_size_for(FRAME_SAMPLES + (uint32_t)MAX_LAG_SAMPLES);
+    cfg.az_start_deg = -88.75f;
+    cfg.az_step_deg = 2.5f;
+    cfg.grid_n = 72u;
+
+    if (doa_srp_init(&cfg) != 0)
+    {
+        printf("[DOA] srp init failed\r\n");
+        return -1;
+    }
+    return 0;
+}
+#endif
+
+/**
+ * @brief 串口命令: "doa" 列出后端, "doa <name>" 切换后端
+ */
+static void app_handle_command(const char *cmd)
+{
+    if (strcmp(cmd, "doa") == 0)
+    {
+        app_print_backends();
+    }
+    else if (strncmp(cmd, "doa ", 4) == 0)
+    {
+        if (doa_backend_select_by_name(cmd + 4) == 0)
+        {
+            doa_overrun_cnt = 0;
+            printf("[DOA] backend -> %s\r\n", doa_backend_get(doa_backend_current())->name);
+            if (doa_backend_current() == DOA_BACKEND_GCC_PHAT && GCC_W_NEEDS_AVG(doa_gcc_get_weighting()))
+            {
+                printf("[DOA] note: %s acts as phat on single frames (use gcc_phat_avg)\r\n",
+                       gcc_weighting_names[doa_gcc_get_weighting()]);
+            }
+        }
+        else
+        {
+            printf("[DOA] unknown backend '%s'\r\n", cmd + 4);
+        }
+    }
+    else if (strcmp(cmd, "lms on") == 0 || strcmp(cmd, "lms off") == 0)
+    {
+        app_set_lms_track(cmd[5] == 'n');
+        printf("[DOA] lms tracking %s\r\n", lms_track ? "on" : "off");
+    }
+    else if (strncmp(cmd, "beacon ", 7) == 0)
+    {
+        app_handle_beacon(cmd + 7);
+    }
+    else if (strncmp(cmd, "gccw ", 5) == 0)
+    {
+        app_handle_gccw(cmd + 5);
+    }
+    else if (strcmp(cmd, "slope on") == 0 || strcmp(cmd, "slope off") == 0)
+    {
+        // 仅 GCC 后端有效: 亚采样 lag 由互谱相位斜率代替三点插值
+        doa_gcc_set_phase_slope(cmd[7] == 'n');
+        printf("[DOA] phase slope %s\r\n", doa_gcc_get_phase_slope() ? "on" : "off");
+    }
+#if DOA_ARRAY_ENGINES
+    else if (strcmp(cmd, "music on") == 0 || strcmp(cmd, "music off") == 0)
+    {
+        music_on = (cmd[7] == 'n');
+        app_music_init();
+        printf("[DOA] music %s\r\n", music_on ? "on" : "off");
+    }
+    else if (strcmp(cmd, "srp on") == 0 || strcmp(cmd, "srp off") == 0)
+    {
+        srp_on = (cmd[5] == 'n') && (app_srp_init() == 0);
+        printf("[DOA] srp %s\r\n", srp_on ? "on" : "off");
+    }
+#endif
+    else
+    {
+        printf("[CMD] unknown '%s'\r\n", cmd);
+    }
+}
+
+/**
+ * @brief DOA 计时与超时降级
+ */
+static void app_check_doa_deadline(uint32_t cycles)
+{
+    doa_last_cycles = cycles;
+    doa_backend_record_cycles(cycles);
+
+    if (cycles <= doa_budget_cycles)
+    {
+        doa_overrun_cnt = 0;
+        return;
+    }
+
+    if (++doa_overrun_cnt >= DOA_OVERRUN_FRAMES)
+    {
+        doa_overrun_cnt = 0;
+        if (doa_backend_fallback() == 0)
+        {
+            printf("[DOA] %lucyc > budget %lucyc, fallback -> %s\r\n",
+                   (unsigned long)cycles, (unsigned long)doa_budget_cycles,
+                   doa_backend_get(doa_backend_current())->name);
+        }
+    }
+}
+
 /**
  * @brief 应用初始化
  */
 void app_init(void)
 {
     printf("\r\n========== 2-Mic DOA -> Servo (Gain Mapping) ==========\r\n");
-    printf("FS=%.0fHz, frame=%lu/ch, MAX_LAG=%d, micDist=%.2fm\r\n",
-           FS_HZ, (unsigned long)FRAME_SAMPLES, (int)MAX_LAG_SAMPLES, (double)MIC_DIST_M);
-    printf("Servo: min=%dus max=%dus center=%dus  K=%.2fus/lag  alpha=%.2f  E_TH=%lu\r\n",
+    printf("FS=%.0fHz, frame=%lu/ch, hop=%lu/ch, MAX_LAG=%d, micDist=%.2fm\r\n",
+           FS_HZ, (unsigned long)FRAME_SAMPLES, (unsigned long)HOP_SAMPLES,
+           (int)MAX_LAG_SAMPLES, (double)MIC_DIST_M);
+    printf("Servo: min=%dus max=%dus center=%dus  K=%.2fus/deg  alpha=%.2f  E_TH=%lu\r\n",
            SERVO_US_MIN, SERVO_US_MAX, SERVO_US_CENTER,
-           (double)SERVO_K_US_PER_LAG, (double)SERVO_ALPHA, (unsigned long)ENERGY_TH);
+           (double)SERVO_US_PER_DEG, (double)SERVO_ALPHA, (unsigned long)ENERGY_TH);
+
+    // DWT 周期计数器(DOA 计时)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    doa_budget_cycles = (uint32_t)((float)SystemCoreClock * ((float)HOP_SAMPLES / FS_HZ) *
+                                   ((float)DOA_DEADLINE_PCT / 100.0f));
+#if AUDIO_DECIM_R > 1u
+    // 抽取开销与数据无关,固定从 DOA 预算里预留
+    uint32_t decim_cycles = AUDIO_HALF_PAIRS * AUDIO_DECIM_CYC_PER_PAIR;
+    doa_budget_cycles = (doa_budget_cycles > decim_cycles) ? (doa_budget_cycles - decim_cycles) : 0u;
+    printf("Oversample: ADC=%.0fHz /%lu, CIC%lu + FIR%lu, +%lu bits, decim ~%lucyc/hop\r\n",
+           (double)ADC_FS_HZ, (unsigned long)AUDIO_DECIM_R, (unsigned long)AUDIO_DECIM_STAGES,
+           (unsigned long)AUDIO_DECIM_TAPS, (unsigned long)AUDIO_SAMPLE_FRAC_BITS, (unsigned long)decim_cycles);
+#endif
+
+    doa_init();
+#if AUDIO_HIGH_RATE
+    // 高采样率: lag 范围 5 倍,全 lag NCC 超出预算,默认用粗到细
+    // (精算前 NCC_C2F_PEAKS 个粗峰,置信度/top-K 与全 lag NCC 一致)
+    (void)doa_backend_select(DOA_BACKEND_NCC_C2F);
+#endif
+    doa_angle_init();
+#if DOA_ARRAY_ENGINES
+    app_music_init();
+#endif
+    printf("DOA backends (budget %lucyc, cmd: doa [name]):\r\n", (unsigned long)doa_budget_cycles);
+    app_print_backends();
+
+    // 起振窗口换算为帧数(至少 1 帧)
+    doa_onset_init((uint32_t)((float)DOA_ONSET_WINDOW_MS * 0.001f * FS_HZ / (float)HOP_SAMPLES) + 1u,
+                   DOA_ONSET_RATIO, DOA_ONSET_ENV_ALPHA);
+
+    (void)doa_hist_init(MAX_LAG_SAMPLES, DOA_HIST_DECAY);
+    lms_ok = (doa_lms_init(MAX_LAG_SAMPLES, DOA_LMS_MU) == 0);
+    app_set_lms_track(lms_track);
 
     servo_init();
     audio_capture_init();
+    uart_cmd_start();
 
     last_tick_ms = HAL_GetTick();
     printf("ADC+DMA started. Tracking lag -> servo...\r\n");
@@ -47,41 +385,161 @@ void app_loop(void)
         uint32_t total_hz = (count * 1000u) / (dt ? dt : 1u);
         uint32_t per_ch_hz = total_hz / 2u;
 
-        printf("[Sampling] total=%lu/s, per_ch=%lu Hz\r\n",
-               (unsigned long)total_hz, (unsigned long)per_ch_hz);
+        // 半区处理情况: 丢弃/作废应为 0,最小余量越接近整个半区越从容;
+        // 串口为中断发送,打印不占主循环时间,遥测超出带宽时丢的是输出(txdrop)而不是采样
+        audio_stats_t st;
+        audio_get_stats(&st, 1);
+
+        printf("[Sampling] total=%lu/s, per_ch=%lu Hz | seq=%lu halves=%lu drop=%lu late=%lu slack_min=%lu/%lu txdrop=%lu\r\n",
+               (unsigned long)total_hz, (unsigned long)per_ch_hz,
+               (unsigned long)st.seq, (unsigned long)st.halves, (unsigned long)st.dropped,
+               (unsigned long)st.late, (unsigned long)st.slack_min, (unsigned long)AUDIO_HALF_PAIRS,
+               (unsigned long)uart_tx_dropped());
 
         HAL_GPIO_TogglePin(LED_PORT, LED_PIN);
     }
 
-    // 每帧处理:lag -> servo
-    if (frame_ready)
+    // 串口命令
+    char cmd[UART_CMD_MAX];
+    if (uart_cmd_poll(cmd, sizeof(cmd)))
     {
-        frame_ready = 0;
-        frame_cnt++;
+        app_handle_command(cmd);
+    }
 
-        audio_split_and_remove_dc(adc_buffer, mic0, mic1, FRAME_SAMPLES);
+    // 每 hop 处理一帧:lag -> servo
+    uint32_t tc = DWT->CYCCNT;
+    if (audio_ring_poll())
+    {
+        cap_last_cycles = DWT->CYCCNT - tc;
+        frame_cnt++;
 
-        uint32_t e0 = audio_frame_energy(mic0, FRAME_SAMPLES);
-        uint32_t e1 = audio_frame_energy(mic1, FRAME_SAMPLES);
+        uint32_t e0, e1;
+        audio_ring_frame(mic0, mic1, &e0, &e1);
 
         uint8_t valid = (e0 > ENERGY_TH) || (e1 > ENERGY_TH);
 
-        int32_t lag = 0;
+#if DOA_ONSET_GATE
+        // 混响尾部: 不做估计(省周期),舵机保持在直达声方向
+        if (doa_onset_update((e0 > e1) ? e0 : e1, ENERGY_TH) == DOA_ONSET_TAIL)
+        {
+            valid = 0;
+            tail_skip_cnt++;
+        }
+#endif
+        frame_active = valid;
+
+        doa_result_t res = {0};
+        doa_peak_t peaks[DOA_TOPK];
+        uint32_t npeaks = 0;
         if (valid)
         {
-            lag = doa_estimate_lag(mic0, mic1, FRAME_SAMPLES, MAX_LAG_SAMPLES);
+            uint32_t t0 = DWT->CYCCNT;
+            if (doa_goertzel_tones() > 0u)
+            {
+                // 信标模式: 每音调每采样几次乘加,置信度取音调纯度
+                res.confidence = doa_goertzel_estimate(mic0, mic1, FRAME_SAMPLES, MAX_LAG_SAMPLES, &res.lag_q16);
+                res.lag = (res.lag_q16 + DOA_Q16_ONE / 2) >> 16;
+                doa_last_cycles = DWT->CYCCNT - t0;
+            }
+            else
+            {
+                doa_estimate(mic0, mic1, FRAME_SAMPLES, MAX_LAG_SAMPLES, &res);
+                app_check_doa_deadline(DWT->CYCCNT - t0);
+
+                // 同一相关函数上取多峰(多说话人)
+                npeaks = doa_last_topk(peaks, DOA_TOPK);
+            }
+
+#if DOA_ARRAY_ENGINES
+            if (music_on)
+            {
+                // 有声帧才更新协方差,周期含 FFT + 特征分解 + 扫描
+                const int16_t *const ch[2] = {mic0, mic1};
+                uint32_t tm = DWT->CYCCNT;
+                doa_music_update(ch, FRAME_SAMPLES);
+                music_az = doa_music_estimate();
+                music_cycles = DWT->CYCCNT - tm;
+            }
+            if (srp_on)
+            {
+                // 每路一次正变换 + 每对一次逆变换 + 查表累加
+                const int16_t *const ch[2] = {mic0, mic1};
+                uint32_t ts = DWT->CYCCNT;
+                srp_az = doa_srp_estimate(ch, FRAME_SAMPLES);
+                srp_cycles = DWT->CYCCNT - ts;
+            }
+#endif
+
+            // 按置信度投票,离群帧权重小,不会把主导方向拉走
+            doa_hist_update(res.lag_q16, res.confidence);
+
+            // 混响/多峰帧: 有能量但峰不突出,不动舵机
+            if (res.confidence < DOA_CONF_TH)
+            {
+                valid = 0;
+                low_conf_cnt++;
+            }
+        }
+        else
+        {
+            // 静音/混响尾部也按帧衰减: 声源停止后旧方向逐渐失效,下一次起振很快就能接管众数
+            doa_hist_update(0, 0.0f);
         }
 
-        servo_track_from_lag(lag, valid);
+        // 舵机: 单帧 lag / 直方图主导 lag / NLMS(块估计只用于遥测)
+        int32_t lag_q16 = res.lag_q16;
+#if DOA_HIST_SERVO
+        lag_q16 = doa_hist_mode_q16();
+#endif
+        app_servo_update(&lag_q16, &valid);
 
         if ((frame_cnt % PRINT_EVERY_NFRAMES) == 0u)
         {
             int out_us = servo_get_current_us();
-            printf("E0=%lu E1=%lu | valid=%u | lag=%ld | pwm=%dus\r\n",
+            audio_stats_t st;
+            audio_get_stats(&st, 0);
+#if DOA_ARRAY_ENGINES
+            if (music_on)
+            {
+                printf("  music az=%.1f %lucyc\r\n", (double)music_az, (unsigned long)music_cycles);
+            }
+            if (srp_on)
+            {
+                printf("  srp az=%.1f %lucyc\r\n", (double)srp_az, (unsigned long)srp_cycles);
+            }
+#endif
+            if (npeaks > 1u)
+            {
+                printf("  peaks:");
+                for (uint32_t i = 0; i < npeaks; i++)
+                {
+                    printf(" %.2f(%.2f)", (double)peaks[i].lag_q16 / (double)DOA_Q16_ONE, (double)peaks[i].score);
+                }
+                printf("\r\n");
+            }
+            printf("#%lu drop=%lu late=%lu | E0=%lu E1=%lu | valid=%u | lag=%.2f dom=%.2f(%.2f) az=%.1f conf=%.2f psr=%.1f lowc=%lu tail=%lu | pwm=%dus | %s %lucyc cap=%lucyc\r\n",
+                   (unsigned long)st.seq, (unsigned long)st.dropped, (unsigned long)st.late,
                    (unsigned long)e0, (unsigned long)e1,
-                   (unsigned)valid, (long)lag, out_us);
+                   (unsigned)valid, (double)res.lag_q16 / (double)DOA_Q16_ONE,
+                   (double)doa_hist_mode_q16() / (double)DOA_Q16_ONE, (double)doa_hist_strength(),
+                   (double)doa_angle_from_lag_q16(lag_q16) * 0.01,
+                   (double)res.confidence, (double)res.psr, (unsigned long)low_conf_cnt, (unsigned long)tail_skip_cnt, out_us,
+                   (doa_goertzel_tones() > 0u) ? "beacon" : doa_backend_get(doa_backend_current())->name,
+                   (unsigned long)doa_last_cycles, (unsigned long)cap_last_cycles);
         }
     }
+    else if (lms_track)
+    {
+        // 环未攒满(启动/作废重攒)时 NLMS 仍随半区推进,舵机不必等第一帧
+        int32_t lag_q16 = 0;
+        uint8_t valid = 0;
+        app_servo_update(&lag_q16, &valid);
+    }
 
-    HAL_Delay(1);
+    // 没有待处理的半区才睡眠,由 DMA 半区中断(或 SysTick / 串口)唤醒,不额外占用帧移时间;
+    // 关中断后检查再 WFI: 检查与睡眠之间到达的中断仍会唤醒(PRIMASK 不挡 WFI 唤醒)
+    __disable_irq();
+    if (!audio_half_pending())
+        __WFI();
+    __enable_irq();
 }
@@ -1,19 +1,54 @@
 #include "audio_capture.h"
+#include "audio_decim.h"
 #include "adc.h"
 #include "dma.h"
 #include "tim.h"
 #include "main.h"
 #include <stdint.h>
 
-// 音频缓冲区定义
-uint16_t adc_buffer[ADC_BUFFER_SIZE];
+// 音频缓冲区定义(4 字节对齐: 双 ADC 模式按 32bit 写入,拆分时也按 32bit 读取)
+__ALIGNED(4) uint16_t adc_buffer[ADC_BUFFER_SIZE];
 int16_t mic0[FRAME_SAMPLES];
 int16_t mic1[FRAME_SAMPLES];
 
 // 全局变量定义
-volatile uint8_t frame_ready = 0;
 volatile uint32_t sample_count_total = 0;
 
+// 每通道环形缓冲(最近 FRAME_SAMPLES 个原始采样)
+static int16_t ring0[FRAME_SAMPLES];
+static int16_t ring1[FRAME_SAMPLES];
+static uint32_t ring_wr = 0;      // 下一个写入位置(也是最旧采样)
+static uint32_t ring_fill = 0;    // 有效采样数
+
+// 半区序号: DMA 中断里递增(已写完的半区数),处理方读到哪个
+static volatile uint32_t half_wr_seq = 0;
+static uint32_t half_rd_seq = 0;
+
+// DMA 每个采样对的传输次数: 双 ADC 一次 32bit,单 ADC 两次 16bit(NDTR 以传输次数计)
+#if AUDIO_CAPTURE_DUAL_ADC
+#define AUDIO_DMA_XFERS_PER_PAIR 1u
+#else
+#define AUDIO_DMA_XFERS_PER_PAIR 2u
+#endif
+
+// 采集统计
+static audio_stats_t stats = {0, 0, 0, 0, AUDIO_HALF_PAIRS};
+
+#if AUDIO_DECIM_R > 1u
+// 抽取输出(一个半区 -> HOP_SAMPLES 个采样对)
+static int16_t decim0[HOP_SAMPLES];
+static int16_t decim1[HOP_SAMPLES];
+#endif
+
+// 逐采样回调(如自适应时延估计)
+static audio_sample_hook_t sample_hook = NULL;
+
+// 窗内滑动和(跨帧复用,求直流/能量不必重扫整帧)
+static int32_t ring_sum0 = 0;
+static int32_t ring_sum1 = 0;
+static uint64_t ring_sq0 = 0;
+static uint64_t ring_sq1 = 0;
+
 /**
  * @brief 拆分双通道交错 + 去直流
  * src: [ch0, ch1, ch0, ch1 ...]
@@ -52,32 +87,259 @@ uint32_t audio_frame_energy(const int16_t *x, uint32_t n)
     return (uint32_t)(acc / n);
 }
 
+/**
+ * @brief 一个采样对入环,同时更新滑动和
+ */
+static inline void ring_push(int16_t v0, int16_t v1)
+{
+    if (ring_fill == FRAME_SAMPLES)
+    {
+        int32_t o0 = ring0[ring_wr];
+        int32_t o1 = ring1[ring_wr];
+        ring_sum0 -= o0;
+        ring_sum1 -= o1;
+        ring_sq0 -= (uint64_t)(o0 * o0);
+        ring_sq1 -= (uint64_t)(o1 * o1);
+    }
+    else
+    {
+        ring_fill++;
+    }
+
+    ring0[ring_wr] = v0;
+    ring1[ring_wr] = v1;
+    ring_sum0 += v0;
+    ring_sum1 += v1;
+    ring_sq0 += (uint64_t)((int32_t)v0 * v0);
+    ring_sq1 += (uint64_t)((int32_t)v1 * v1);
+
+    ring_wr++;
+    if (ring_wr == FRAME_SAMPLES)
+        ring_wr = 0;
+}
+
+/**
+ * @brief 采样不连续: 清空环形缓冲,重新攒满一帧
+ */
+static void ring_reset(void)
+{
+    ring_fill = 0;
+    ring_wr = 0;
+    ring_sum0 = ring_sum1 = 0;
+    ring_sq0 = ring_sq1 = 0;
+}
+
+/**
+ * @brief DMA 距离写到半区 h 还剩多少采样对
+ * h 刚写完时 DMA 在另一半: h = 0 时剩余 NDTR(回绕前),h = 1 时剩余 NDTR - 半区
+ */
+static uint32_t half_slack_pairs(uint32_t h)
+{
+    uint32_t ndtr = __HAL_DMA_GET_COUNTER(hadc1.DMA_Handle);
+    uint32_t half_xfers = AUDIO_HALF_PAIRS * AUDIO_DMA_XFERS_PER_PAIR;
+
+    if (h != 0u)
+        ndtr = (ndtr > half_xfers) ? (ndtr - half_xfers) : 0u;
+
+    uint32_t slack = ndtr / AUDIO_DMA_XFERS_PER_PAIR;
+    return (slack > AUDIO_HALF_PAIRS) ? AUDIO_HALF_PAIRS : slack;
+}
+
+/**
+ * @brief 是否有未处理的半区
+ */
+uint8_t audio_half_pending(void)
+{
+    return (half_wr_seq != half_rd_seq) ? 1u : 0u;
+}
+
+/**
+ * @brief 取最旧的未处理半区
+ * 序号为偶数的半区在 adc_buffer 前半,奇数在后半;
+ * 落后 >= 2 个半区说明该半区已被 DMA 重新写入,丢弃并跳到最新的半区
+ */
+uint8_t audio_half_acquire(audio_half_t *half)
+{
+    uint32_t wr = half_wr_seq;
+
+    if (wr == half_rd_seq)
+        return 0;
+
+    if (wr - half_rd_seq >= 2u)
+    {
+        stats.dropped += wr - half_rd_seq - 1u;
+        half_rd_seq = wr - 1u;
+        ring_reset();
+    }
+
+    // 读 NDTR 前后又完成了一个半区: DMA 已进入该半区,余量为 0(交还时计入 late)
+    uint32_t slack = half_slack_pairs(half_rd_seq & 1u);
+    if (half_wr_seq - half_rd_seq >= 2u)
+        slack = 0;
+    if (slack < stats.slack_min)
+        stats.slack_min = slack;
+
+    half->seq = half_rd_seq;
+    half->pairs = (const uint32_t *)&adc_buffer[(half_rd_seq & 1u) * (ADC_BUFFER_SIZE / 2u)];
+    half_rd_seq++;
+    stats.seq = half->seq;
+    stats.halves++;
+    return 1;
+}
+
+/**
+ * @brief 交还半区
+ * 该半区写完时 half_wr_seq = seq + 1;再完成一个半区(另一半)后 DMA 就回绕到该半区了
+ */
+uint8_t audio_half_release(const audio_half_t *half)
+{
+    if ((half_wr_seq - half->seq) < 2u)
+        return 1;
+
+    stats.late++;
+    return 0;
+}
+
+/**
+ * @brief 把一个独占的半区搬入环形缓冲
+ * 每个新半区(HOP_SAMPLES 个采样)且环形缓冲已满时返回 1
+ */
+uint8_t audio_ring_poll(void)
+{
+    audio_half_t half;
+    if (!audio_half_acquire(&half))
+        return 0;
+
+#if AUDIO_DECIM_R > 1u
+    // 过采样: 整个半区先抽取到 FS_HZ 再入环
+    uint32_t m = audio_decim_half(half.pairs, AUDIO_HALF_PAIRS, decim0, decim1);
+    for (uint32_t i = 0; i < m; i++)
+    {
+        ring_push(decim0[i], decim1[i]);
+        if (sample_hook != NULL)
+            sample_hook(decim0[i], decim1[i]);
+    }
+#else
+    // 单 ADC 扫描与双 ADC 打包在内存中布局相同(小端: ch0 在低半字),一次 32bit 读一对
+    const uint32_t *src = half.pairs;
+    for (uint32_t i = 0; i < AUDIO_HALF_PAIRS; i++)
+    {
+        uint32_t w = src[i];
+        int16_t v0 = (int16_t)(w & 0xFFFFu);
+        int16_t v1 = (int16_t)(w >> 16);
+        ring_push(v0, v1);
+        if (sample_hook != NULL)
+            sample_hook(v0, v1);
+    }
+#endif
+
+    // 搬运期间被 DMA 追上: 环里混入了新旧两轮数据,作废重攒
+    if (!audio_half_release(&half))
+    {
+        ring_reset();
+        return 0;
+    }
+    return (ring_fill == FRAME_SAMPLES);
+}
+
+/**
+ * @brief 环形缓冲展开为一帧 + 去直流,能量由滑动和直接算出(与 audio_frame_energy 结果一致)
+ */
+void audio_ring_frame(int16_t *a, int16_t *b, uint32_t *e0, uint32_t *e1)
+{
+    const int32_t n = (int32_t)FRAME_SAMPLES;
+    int16_t dc0 = (int16_t)(ring_sum0 / n);
+    int16_t dc1 = (int16_t)(ring_sum1 / n);
+
+    uint32_t idx = ring_wr;
+    for (uint32_t i = 0; i < FRAME_SAMPLES; i++)
+    {
+        a[i] = ring0[idx] - dc0;
+        b[i] = ring1[idx] - dc1;
+        idx++;
+        if (idx == FRAME_SAMPLES)
+            idx = 0;
+    }
+
+    // sum((x - dc)^2) = sum(x^2) - 2*dc*sum(x) + n*dc^2
+    int64_t q0 = (int64_t)ring_sq0 - 2 * (int64_t)dc0 * ring_sum0 + (int64_t)n * dc0 * dc0;
+    int64_t q1 = (int64_t)ring_sq1 - 2 * (int64_t)dc1 * ring_sum1 + (int64_t)n * dc1 * dc1;
+    *e0 = (uint32_t)(q0 / n);
+    *e1 = (uint32_t)(q1 / n);
+}
+
+/**
+ * @brief 设置逐采样回调
+ */
+void audio_set_sample_hook(audio_sample_hook_t hook)
+{
+    sample_hook = hook;
+}
+
+/**
+ * @brief 读取采集统计,可选重新开始统计最小余量
+ */
+void audio_get_stats(audio_stats_t *st, uint8_t restart_slack)
+{
+    *st = stats;
+    if (restart_slack)
+        stats.slack_min = AUDIO_HALF_PAIRS;
+}
+
 /**
  * @brief 初始化音频捕获
  */
 void audio_capture_init(void)
 {
+#if AUDIO_DECIM_R > 1u
+    audio_decim_init();
+#endif
+
     // 启动 TIM2(触发 ADC)
     if (HAL_TIM_Base_Start(&htim2) != HAL_OK)
     {
         Error_Handler();
     }
 
+#if AUDIO_CAPTURE_DUAL_ADC
+    // 先使能从 ADC2,再启动主 ADC1 + DMA(长度按 32bit 采样对计)
+    if (HAL_ADC_Start(&hadc2) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    if (HAL_ADCEx_MultiModeStart_DMA(&hadc1, (uint32_t *)adc_buffer, ADC_BUFFER_SIZE / 2u) != HAL_OK)
+    {
+        Error_Handler();
+    }
+#else
     // 启动 ADC + DMA
     if (HAL_ADC_Start_DMA(&hadc1, (uint32_t *)adc_buffer, ADC_BUFFER_SIZE) != HAL_OK)
     {
         Error_Handler();
     }
+#endif
+}
+
+/**
+ * @brief DMA 半传输回调: 前半区写完,DMA 转去写后半区
+ */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1)
+    {
+        half_wr_seq++;
+        sample_count_total += ADC_BUFFER_SIZE / 2u;
+    }
 }
 
 /**
- * @brief DMA 回调
+ * @brief DMA 传输完成回调: 后半区写完,DMA 回绕写前半区
  */
 void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
 {
     if (hadc->Instance == ADC1)
     {
-        sample_count_total += ADC_BUFFER_SIZE;
-        frame_ready = 1;
+        half_wr_seq++;
+        sample_count_total += ADC_BUFFER_SIZE / 2u;
     }
 }
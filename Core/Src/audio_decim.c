@@ -0,0 +1,111 @@
+#include "audio_decim.h"
+#include <stdint.h>
+
+// 补偿 FIR 半边系数(中心抽头在最后): 输出采样率归一化下 0~0.22 通带反 sinc^4 补偿(波动 < 0.5dB),
+// 0.36 以上阻带 > 45dB;直流增益 1。CIC 通带下垂在 R >= 4 时几乎与 R 无关,同一组系数通用
+static const float decim_fir_half[AUDIO_DECIM_TAPS / 2u + 1u] = {
+    -0.012967f, -0.023711f, 0.035261f, 0.055963f, -0.105125f, -0.113447f, 0.333254f, 0.661541f,
+};
+
+// 单通道滤波器状态: CIC 积分/梳状(uint32 回绕运算,最终差分结果正确),FIR 延迟线(双份,免取模)
+typedef struct
+{
+    uint32_t integ[AUDIO_DECIM_STAGES];
+    uint32_t comb[AUDIO_DECIM_STAGES];
+    int32_t hist[2u * AUDIO_DECIM_TAPS];
+    uint32_t pos;
+} decim_ch_t;
+
+static decim_ch_t decim_ch0;
+static decim_ch_t decim_ch1;
+
+// 定点系数(Q AUDIO_DECIM_COEF_SHIFT)
+static int32_t decim_coef[AUDIO_DECIM_TAPS / 2u + 1u];
+
+/**
+ * @brief 生成定点 FIR 系数并清零状态
+ * 系数 = h * 2^FRAC_BITS / R^N * 2^COEF_SHIFT,CIC 增益在 FIR 里一并归一
+ */
+void audio_decim_init(void)
+{
+    float gain = 1.0f;
+    for (uint32_t s = 0; s < AUDIO_DECIM_STAGES; s++)
+        gain *= (float)AUDIO_DECIM_R;
+
+    float scale = (float)(1u << AUDIO_SAMPLE_FRAC_BITS) * (float)(1u << AUDIO_DECIM_COEF_SHIFT) / gain;
+    for (uint32_t k = 0; k < AUDIO_DECIM_TAPS / 2u + 1u; k++)
+    {
+        float c = decim_fir_half[k] * scale;
+        decim_coef[k] = (int32_t)(c + ((c >= 0.0f) ? 0.5f : -0.5f));
+    }
+
+    decim_ch0 = (decim_ch_t){0};
+    decim_ch1 = (decim_ch_t){0};
+}
+
+/**
+ * @brief CIC 积分(每个输入采样)
+ */
+static inline void decim_integrate(decim_ch_t *ch, int32_t x)
+{
+    uint32_t v = (uint32_t)x;
+    for (uint32_t s = 0; s < AUDIO_DECIM_STAGES; s++)
+    {
+        ch->integ[s] += v;
+        v = ch->integ[s];
+    }
+}
+
+/**
+ * @brief CIC 梳状 + 补偿 FIR(每个输出采样),饱和到 int16
+ */
+static inline int16_t decim_output(decim_ch_t *ch)
+{
+    uint32_t v = ch->integ[AUDIO_DECIM_STAGES - 1u];
+    for (uint32_t s = 0; s < AUDIO_DECIM_STAGES; s++)
+    {
+        uint32_t d = v - ch->comb[s];
+        ch->comb[s] = v;
+        v = d;
+    }
+
+    // 延迟线倒序写入,w[0] 为最新
+    ch->pos = (ch->pos == 0u) ? (AUDIO_DECIM_TAPS - 1u) : (ch->pos - 1u);
+    ch->hist[ch->pos] = (int32_t)v;
+    ch->hist[ch->pos + AUDIO_DECIM_TAPS] = (int32_t)v;
+    const int32_t *w = &ch->hist[ch->pos];
+
+    // 对称系数: 先把成对抽头相加,乘法减半
+    int64_t acc = (int64_t)decim_coef[AUDIO_DECIM_TAPS / 2u] * w[AUDIO_DECIM_TAPS / 2u];
+    for (uint32_t k = 0; k < AUDIO_DECIM_TAPS / 2u; k++)
+        acc += (int64_t)decim_coef[k] * (w[k] + w[AUDIO_DECIM_TAPS - 1u - k]);
+
+    int32_t y = (int32_t)((acc + ((int64_t)1 << (AUDIO_DECIM_COEF_SHIFT - 1))) >> AUDIO_DECIM_COEF_SHIFT);
+    if (y > 32767)
+        y = 32767;
+    if (y < -32768)
+        y = -32768;
+    return (int16_t)y;
+}
+
+/**
+ * @brief 抽取一个半区
+ * 每个输出: AUDIO_DECIM_R 次积分 + 一次梳状/FIR,开销与数据无关(固定每采样周期数)
+ */
+uint32_t audio_decim_half(const uint32_t *pairs, uint32_t n, int16_t *out0, int16_t *out1)
+{
+    uint32_t m = n / AUDIO_DECIM_R;
+
+    for (uint32_t k = 0; k < m; k++)
+    {
+        for (uint32_t r = 0; r < AUDIO_DECIM_R; r++)
+        {
+            uint32_t w = *pairs++;
+            decim_integrate(&decim_ch0, (int32_t)(w & 0xFFFFu) - AUDIO_DECIM_MID);
+            decim_integrate(&decim_ch1, (int32_t)(w >> 16) - AUDIO_DECIM_MID);
+        }
+        out0[k] = decim_output(&decim_ch0);
+        out1[k] = decim_output(&decim_ch1);
+    }
+    return m;
+}
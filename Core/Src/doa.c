@@ -1,10 +1,235 @@
 #include "doa.h"
 #include "doa_ncc.h"
+#include "doa_gcc_phat.h"
+#include "doa_peak.h"
+#include <string.h>
+
+// 后端表(顺序与 doa.h 中 DOA_BACKEND_* 一致,周期为估算值)
+// GCC 的代价取决于 FFT 点数而与 lag 范围无关(512 点补零到 1024,三次变换;高采样率 1024 点补零到 2048),
+// NCC 随 2*max_lag+1 线性增长;+-16 lag 时 SMLALD 版 NCC 更便宜,lag 范围大时 GCC 占优
+static const doa_backend_t doa_backends[] = {
+    {"ncc", NULL, doa_ncc_corr, 0u, 25000u},
+    {"ncc_c2f", NULL, doa_ncc_corr_c2f, NCC_C2F_SCRATCH_BYTES, 18000u},
+    {"gcc_phat", NULL, doa_gcc_phat_corr, GCC_SCRATCH_BYTES, 100000u * (FFT_MAX_N / 1024u)},
+    {"gcc_phat_avg", doa_gcc_avg_reset, doa_gcc_phat_avg_corr, GCC_AVG_SCRATCH_BYTES, 105000u * (FFT_MAX_N / 1024u)},
+    {"ncc_q", NULL, doa_ncc_corr_q, NCC_Q_SCRATCH_BYTES, 22000u},
+};
+
+#define DOA_NUM_BACKENDS (sizeof(doa_backends) / sizeof(doa_backends[0]))
+
+// 当前后端
+static const doa_backend_t *doa_cur = &doa_backends[DOA_DEFAULT_BACKEND];
+
+// 各后端实测周期(DWT 指数平均,0 = 尚未运行)
+static uint32_t doa_meas_cycles[DOA_NUM_BACKENDS];
+
+// 相关函数缓冲区(所有后端共用),以及它对应的 max_lag(0 = 尚无数据)
+static float doa_corr[DOA_CORR_MAX_LEN];
+static int32_t doa_corr_max_lag = 0;
+
+/**
+ * @brief 当前后端计算相关函数到 doa_corr,返回实际使用的 max_lag
+ */
+static int32_t doa_compute_corr(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
+{
+  if (max_lag > DOA_CORR_MAX_LAG)
+    max_lag = DOA_CORR_MAX_LAG;
+
+  // 丢弃上一帧未取走的相位斜率(本帧非 GCC 后端时不得误用)
+  (void)doa_gcc_take_slope(0, 0);
+  doa_cur->corr(x, y, n, max_lag, doa_corr);
+  doa_corr_max_lag = max_lag;
+  return max_lag;
+}
+
+/**
+ * @brief 初始化: 选中默认后端
+ */
+void doa_init(void)
+{
+  (void)doa_backend_select(DOA_DEFAULT_BACKEND);
+}
+
+/**
+ * @brief 后端数量
+ */
+uint32_t doa_backend_count(void)
+{
+  return (uint32_t)DOA_NUM_BACKENDS;
+}
+
+/**
+ * @brief 按编号取后端描述,非法返回 NULL
+ */
+const doa_backend_t *doa_backend_get(uint32_t id)
+{
+  return (id < DOA_NUM_BACKENDS) ? &doa_backends[id] : NULL;
+}
+
+/**
+ * @brief 当前后端编号
+ */
+uint32_t doa_backend_current(void)
+{
+  return (uint32_t)(doa_cur - doa_backends);
+}
+
+/**
+ * @brief 按编号切换后端
+ */
+int doa_backend_select(uint32_t id)
+{
+  if (id >= DOA_NUM_BACKENDS)
+    return -1;
+
+  doa_cur = &doa_backends[id];
+  if (doa_cur->init != NULL)
+    doa_cur->init();
+  return 0;
+}
+
+/**
+ * @brief 按名称切换后端
+ */
+int doa_backend_select_by_name(const char *name)
+{
+  for (uint32_t i = 0; i < DOA_NUM_BACKENDS; i++)
+  {
+    if (strcmp(doa_backends[i].name, name) == 0)
+      return doa_backend_select(i);
+  }
+  return -1;
+}
+
+/**
+ * @brief 记录当前后端的实测周期
+ */
+void doa_backend_record_cycles(uint32_t cycles)
+{
+  uint32_t id = doa_backend_current();
+  uint32_t m = doa_meas_cycles[id];
+
+  doa_meas_cycles[id] = (m == 0u) ? cycles : (m - (m >> 3) + (cycles >> 3));
+}
+
+/**
+ * @brief 后端每帧实测周期
+ */
+uint32_t doa_backend_measured_cycles(uint32_t id)
+{
+  return (id < DOA_NUM_BACKENDS) ? doa_meas_cycles[id] : 0u;
+}
+
+/**
+ * @brief 后端每帧周期(实测优先,未运行过用估算)
+ */
+static uint32_t doa_backend_cycles(uint32_t id)
+{
+  return (doa_meas_cycles[id] != 0u) ? doa_meas_cycles[id] : doa_backends[id].cycles;
+}
 
 /**
- * @brief DOA 估计接口 - 当前使用 NCC 方法
+ * @brief 超时降级: 周期低于当前后端的里面选最贵的(保精度)
+ */
+int doa_backend_fallback(void)
+{
+  uint32_t cur = doa_backend_cycles(doa_backend_current());
+  uint32_t best = DOA_NUM_BACKENDS;
+
+  for (uint32_t i = 0; i < DOA_NUM_BACKENDS; i++)
+  {
+    uint32_t c = doa_backend_cycles(i);
+    if (c >= cur)
+      continue;
+    if (best == DOA_NUM_BACKENDS || c > doa_backend_cycles(best))
+      best = i;
+  }
+
+  if (best == DOA_NUM_BACKENDS)
+    return -1;
+  return doa_backend_select(best);
+}
+
+/**
+ * @brief DOA 估计接口 - 由当前后端计算相关函数后取峰
  */
 int32_t doa_estimate_lag(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
 {
-  return doa_estimate_lag_ncc(x, y, n, max_lag);
+  max_lag = doa_compute_corr(x, y, n, max_lag);
+  return doa_corr_argmax(doa_corr, max_lag);
+}
+
+/**
+ * @brief DOA 估计 - 一次扫描得到主峰/次峰,再插值并计算置信度
+ * confidence = clamp(peak, 0, 1) * (1 - 1/psr),次峰与主峰相当时趋于 0
+ */
+void doa_estimate(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, doa_result_t *res)
+{
+  max_lag = doa_compute_corr(x, y, n, max_lag);
+
+  int32_t lag;
+  float peak, second;
+  doa_corr_peaks(doa_corr, max_lag, &lag, &peak, &second);
+
+  float frac = doa_corr_interp(doa_corr, max_lag, lag);
+  float lag_f = ((float)lag + frac) * (float)DOA_Q16_ONE;
+
+  res->lag = lag;
+  res->lag_q16 = (int32_t)(lag_f + ((lag_f >= 0.0f) ? 0.5f : -0.5f));
+
+  // 相位斜率模式: 与整数峰相差不超过 1 个采样时用斜率 lag 代替三点插值(偏离说明解缠失败/多径)
+  int32_t slope_q16;
+  if (doa_gcc_take_slope(&slope_q16, 0) == 0)
+  {
+    int32_t d = slope_q16 - lag * DOA_Q16_ONE;
+    if (d <= DOA_Q16_ONE && d >= -DOA_Q16_ONE)
+      res->lag_q16 = slope_q16;
+  }
+  res->peak = peak;
+  res->second = second;
+
+  if (peak <= 0.0f)
+  {
+    res->psr = 0.0f;
+    res->confidence = 0.0f;
+    return;
+  }
+
+  float psr = (second > 0.0f) ? (peak / second) : DOA_PSR_MAX;
+  if (psr > DOA_PSR_MAX)
+    psr = DOA_PSR_MAX;
+
+  float p = (peak > 1.0f) ? 1.0f : peak;
+  res->psr = psr;
+  res->confidence = p * (1.0f - 1.0f / psr);
+}
+
+/**
+ * @brief DOA 估计接口 - 整数峰 + 三点插值,输出 Q16.16 lag
+ */
+int32_t doa_estimate_lag_q16(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
+{
+  doa_result_t res;
+  doa_estimate(x, y, n, max_lag, &res);
+  return res.lag_q16;
+}
+
+/**
+ * @brief Top-K 相关峰
+ */
+uint32_t doa_estimate_topk(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag,
+                           doa_peak_t *peaks, uint32_t k)
+{
+  max_lag = doa_compute_corr(x, y, n, max_lag);
+  return doa_corr_topk(doa_corr, max_lag, k, DOA_TOPK_MIN_SEP, peaks);
+}
+
+/**
+ * @brief 复用上一次的相关函数提取 Top-K
+ */
+uint32_t doa_last_topk(doa_peak_t *peaks, uint32_t k)
+{
+  if (doa_corr_max_lag == 0)
+    return 0;
+  return doa_corr_topk(doa_corr, doa_corr_max_lag, k, DOA_TOPK_MIN_SEP, peaks);
 }
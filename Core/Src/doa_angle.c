@@ -0,0 +1,59 @@
+#include "doa_angle.h"
+#include "doa_array.h"
+#include <math.h>
+#include <stdint.h>
+
+#define ANGLE_PI 3.14159265358979f
+
+// 方位角表(0.01 度): tab[i] 对应 lag = i / DOA_ANGLE_STEPS - DOA_ANGLE_MAX_LAG
+static int16_t angle_tab[DOA_ANGLE_TAB_LEN];
+static uint8_t angle_ready = 0;
+
+/**
+ * @brief 生成方位角表
+ * y[i + lag] ~ x[i] 时 lag = -d * sin(az) * fs / c,即 az = asin(-lag * c / (fs * d))
+ */
+void doa_angle_init(void)
+{
+  const float k = SOUND_SPEED_MPS / (FS_HZ * MIC_DIST_M);
+
+  for (int32_t i = 0; i < DOA_ANGLE_TAB_LEN; i++)
+  {
+    float lag = (float)(i - DOA_ANGLE_MAX_LAG * DOA_ANGLE_STEPS) / (float)DOA_ANGLE_STEPS;
+    float s = -lag * k;
+    if (s > 1.0f)
+      s = 1.0f;
+    if (s < -1.0f)
+      s = -1.0f;
+
+    float cdeg = asinf(s) * (18000.0f / ANGLE_PI);
+    angle_tab[i] = (int16_t)(cdeg + ((cdeg >= 0.0f) ? 0.5f : -0.5f));
+  }
+  angle_ready = 1;
+}
+
+/**
+ * @brief 亚采样 lag -> 方位角(0.01 度)
+ */
+int32_t doa_angle_from_lag_q16(int32_t lag_q16)
+{
+  // 先于 doa_angle_init 使用时就地生成,不会读到空表
+  if (!angle_ready)
+    doa_angle_init();
+
+  // 表下标(Q16 小数部分用于插值)
+  const int32_t frac_bits = 16 - DOA_ANGLE_STEPS_SHIFT;
+  const int32_t max_q16 = DOA_ANGLE_MAX_LAG * 65536;
+  if (lag_q16 <= -max_q16)
+    return angle_tab[0];
+  if (lag_q16 >= max_q16)
+    return angle_tab[DOA_ANGLE_TAB_LEN - 1];
+
+  uint32_t pos = (uint32_t)(lag_q16 + max_q16);
+  uint32_t idx = pos >> frac_bits;
+  int32_t frac = (int32_t)(pos & ((1u << frac_bits) - 1u));
+
+  int32_t a0 = angle_tab[idx];
+  int32_t a1 = angle_tab[idx + 1u];
+  return a0 + (((a1 - a0) * frac) >> frac_bits);
+}
@@ -1,14 +1,474 @@
 #include "doa_gcc_phat.h"
+#include "doa_array.h"
+#include "doa_peak.h"
+#include "dsp_fft.h"
+#include <math.h>
+#include <stdint.h>
+
+#define GCC_PI 3.14159265358979f
+
+// 相位斜率法的最高频率: 空间混叠频率 c / (2d)
+#define GCC_SLOPE_F_MAX_HZ (SOUND_SPEED_MPS / (2.0f * MIC_DIST_M))
+
+// 相位斜率法参与拟合的频点: |G| >= 带内最大值 * 该比例
+#define GCC_SLOPE_MIN_REL 0.1f
+
+// 频域工作区(补零到 >= n + max_lag,避免循环相关回绕)
+static float gcc_buf_x[FFT_MAX_N];
+static float gcc_buf_y[FFT_MAX_N];
+static float gcc_corr[DOA_CORR_MAX_LEN];
+
+// 帧间递推平均的互功率谱(未加权,打包格式)与两路自功率谱(每频点一个实数)
+static float gcc_avg[FFT_MAX_N];
+static float gcc_avg_pxx[FFT_MAX_N / 2u];
+static float gcc_avg_pyy[FFT_MAX_N / 2u];
+static uint32_t gcc_avg_nfft = 0;
+static float gcc_avg_forget = GCC_AVG_FORGET;
+
+// 频域加权方式
+static uint8_t gcc_weighting = GCC_W_PHAT;
+static float gcc_beta = GCC_PHAT_BETA;
+
+// 相位斜率模式: 开关,以及本帧由 GCC 前端频谱算出的亚采样 lag / 相位一致度(valid 由取走方清零)
+static uint8_t gcc_slope_on = 0;
+static uint8_t gcc_slope_valid = 0;
+static int32_t gcc_slope_q16 = 0;
+static float gcc_slope_fit = 0.0f;
+
+static void gcc_slope_update(uint32_t nfft, int32_t max_lag);
+
+/**
+ * @brief 单频点加权系数
+ * gr/gi: 互功率谱, pxx/pyy: 自功率谱(单帧时即 |X|^2, |Y|^2)
+ */
+static inline float gcc_weight_bin(float gr, float gi, float pxx, float pyy)
+{
+  float g2 = gr * gr + gi * gi;
+  if (g2 <= 1e-24f)
+    return 0.0f;
+
+  switch (gcc_weighting)
+  {
+  case GCC_W_SCOT:
+  {
+    float d = pxx * pyy;
+    return (d > 1e-24f) ? (1.0f / sqrtf(d)) : 0.0f;
+  }
+
+  case GCC_W_ROTH:
+    return (pxx > 1e-12f) ? (1.0f / pxx) : 0.0f;
+
+  case GCC_W_PHAT_BETA:
+    // |G|^-beta = exp(-beta/2 * ln|G|^2)
+    return expf(-0.5f * gcc_beta * logf(g2));
+
+  case GCC_W_ML:
+  {
+    // Hannan-Thomson: |gamma|^2 / (|G| (1 - |gamma|^2))
+    float d = pxx * pyy;
+    if (d <= 1e-24f)
+      return 0.0f;
+    float c2 = g2 / d;
+    if (c2 > GCC_ML_COH_MAX)
+      c2 = GCC_ML_COH_MAX;
+    return c2 / (sqrtf(g2) * (1.0f - c2));
+  }
+
+  case GCC_W_PHAT:
+  default:
+    return 1.0f / sqrtf(g2);
+  }
+}
 
 /**
- * @brief GCC-PHAT 估计 lag (预留接口,下一步实现)
+ * @brief 互功率谱 G(k) = conj(X(k)) * Y(k),r 可与 xf 相同(原地)
+ */
+static void gcc_cross(const float *xf, const float *yf, float *r, uint32_t nfft)
+{
+  // 直流/奈奎斯特不参与(已去直流)
+  r[0] = 0.0f;
+  r[1] = 0.0f;
+
+  for (uint32_t k = 1; k < nfft / 2u; k++)
+  {
+    float xr = xf[2u * k];
+    float xi = xf[2u * k + 1u];
+    float yr = yf[2u * k];
+    float yi = yf[2u * k + 1u];
+
+    r[2u * k] = xr * yr + xi * yi;
+    r[2u * k + 1u] = xr * yi - xi * yr;
+  }
+}
+
+/**
+ * @brief PHAT 加权: 每个频点归一化到单位幅度,src 可与 dst 相同
+ */
+static void gcc_phat_normalize(const float *src, float *dst, uint32_t nfft)
+{
+  dst[0] = 0.0f;
+  dst[1] = 0.0f;
+
+  for (uint32_t k = 1; k < nfft / 2u; k++)
+  {
+    float rr = src[2u * k];
+    float ri = src[2u * k + 1u];
+    float mag = sqrtf(rr * rr + ri * ri);
+
+    if (mag > 1e-12f)
+    {
+      float inv = 1.0f / mag;
+      dst[2u * k] = rr * inv;
+      dst[2u * k + 1u] = ri * inv;
+    }
+    else
+    {
+      dst[2u * k] = 0.0f;
+      dst[2u * k + 1u] = 0.0f;
+    }
+  }
+}
+
+/**
+ * @brief PHAT 加权互功率谱 R(k) = conj(X(k)) * Y(k) / |X(k) Y(k)|
+ * 输入/输出均为 fft_real_forward 打包格式,r 可与 xf 相同(原地)
+ */
+void gcc_phat_cross(const float *xf, const float *yf, float *r, uint32_t nfft)
+{
+  gcc_cross(xf, yf, r, nfft);
+  gcc_phat_normalize(r, r, nfft);
+}
+
+/**
+ * @brief 两路补零后正变换到 gcc_buf_x / gcc_buf_y,返回 FFT 点数
+ * 补零到 >= n + max_lag;FFT_MAX_N 按本配置的帧长 + lag 定尺寸,
+ * 只有调用者传入更长的帧时才截断到最大 FFT 能容纳的长度
+ */
+static uint32_t gcc_forward(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
+{
+  uint32_t nfft = fft_size_for(n + (uint32_t)max_lag);
+  if (nfft == 0u)
+  {
+    nfft = FFT_MAX_N;
+    n = FFT_MAX_N - (uint32_t)max_lag;
+  }
+
+  for (uint32_t i = 0; i < n; i++)
+  {
+    gcc_buf_x[i] = (float)x[i];
+    gcc_buf_y[i] = (float)y[i];
+  }
+  for (uint32_t i = n; i < nfft; i++)
+  {
+    gcc_buf_x[i] = 0.0f;
+    gcc_buf_y[i] = 0.0f;
+  }
+
+  fft_real_forward(gcc_buf_x, nfft);
+  fft_real_forward(gcc_buf_y, nfft);
+  return nfft;
+}
+
+/**
+ * @brief 逆变换结果取 [-max_lag, max_lag],负 lag 在数组尾部(循环索引)
+ */
+static void gcc_extract(const float *r, uint32_t nfft, int32_t max_lag, float *corr)
+{
+  for (int32_t lag = -max_lag; lag <= max_lag; lag++)
+  {
+    uint32_t idx = (lag < 0) ? (nfft - (uint32_t)(-lag)) : (uint32_t)lag;
+    corr[lag + max_lag] = r[idx];
+  }
+}
+
+/**
+ * @brief GCC-PHAT 相关函数
+ * PHAT 互功率谱逆变换后取 [-max_lag, max_lag]
+ * lag 符号与 doa_estimate_lag_ncc 一致: y[i + lag] ~ x[i]
+ */
+void doa_gcc_phat_corr(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr)
+{
+  uint32_t nfft = gcc_forward(x, y, n, max_lag);
+  gcc_slope_update(nfft, max_lag);
+
+  // 互谱 + 加权,原地写回 gcc_buf_x(不额外占内存)
+  gcc_buf_x[0] = 0.0f;
+  gcc_buf_x[1] = 0.0f;
+  for (uint32_t k = 1; k < nfft / 2u; k++)
+  {
+    float xr = gcc_buf_x[2u * k];
+    float xi = gcc_buf_x[2u * k + 1u];
+    float yr = gcc_buf_y[2u * k];
+    float yi = gcc_buf_y[2u * k + 1u];
+
+    float gr = xr * yr + xi * yi;
+    float gi = xr * yi - xi * yr;
+    float w = gcc_weight_bin(gr, gi, xr * xr + xi * xi, yr * yr + yi * yi);
+
+    gcc_buf_x[2u * k] = gr * w;
+    gcc_buf_x[2u * k + 1u] = gi * w;
+  }
+
+  fft_real_inverse(gcc_buf_x, nfft);
+  gcc_extract(gcc_buf_x, nfft, max_lag, corr);
+}
+
+/**
+ * @brief GCC-PHAT 估计 lag
  */
 int32_t doa_estimate_lag_gcc_phat(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
 {
-  // 待实现
-  (void)x;
-  (void)y;
-  (void)n;
-  (void)max_lag;
+  if (max_lag > DOA_CORR_MAX_LAG)
+    max_lag = DOA_CORR_MAX_LAG;
+
+  doa_gcc_phat_corr(x, y, n, max_lag, gcc_corr);
+  return doa_corr_argmax(gcc_corr, max_lag);
+}
+
+/**
+ * @brief 设置互功率谱遗忘因子 [0, 1),0 = 不平均
+ */
+void doa_gcc_avg_set_forget(float forget)
+{
+  if (forget < 0.0f)
+    forget = 0.0f;
+  if (forget > 0.999f)
+    forget = 0.999f;
+  gcc_avg_forget = forget;
+}
+
+/**
+ * @brief 清空平均状态(下一帧重新开始)
+ */
+void doa_gcc_avg_reset(void)
+{
+  gcc_avg_nfft = 0;
+}
+
+/**
+ * @brief 帧间平均 GCC 相关函数
+ * G_avg = forget * G_avg + (1 - forget) * conj(X) Y,自功率谱同样平均,
+ * 加权作用在平均后的谱上(SCOT/ML 需要平均后的相干函数才有意义,见 GCC_W_NEEDS_AVG)
+ */
+void doa_gcc_phat_avg_corr(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr)
+{
+  uint32_t nfft = gcc_forward(x, y, n, max_lag);
+  gcc_slope_update(nfft, max_lag);
+
+  // 首帧或 FFT 点数变化: 直接装入
+  float a = (gcc_avg_nfft == nfft) ? gcc_avg_forget : 0.0f;
+  float b = 1.0f - a;
+  gcc_avg_nfft = nfft;
+
+  gcc_buf_x[0] = 0.0f;
+  gcc_buf_x[1] = 0.0f;
+  for (uint32_t k = 1; k < nfft / 2u; k++)
+  {
+    float xr = gcc_buf_x[2u * k];
+    float xi = gcc_buf_x[2u * k + 1u];
+    float yr = gcc_buf_y[2u * k];
+    float yi = gcc_buf_y[2u * k + 1u];
+
+    float gr = a * gcc_avg[2u * k] + b * (xr * yr + xi * yi);
+    float gi = a * gcc_avg[2u * k + 1u] + b * (xr * yi - xi * yr);
+    float pxx = a * gcc_avg_pxx[k] + b * (xr * xr + xi * xi);
+    float pyy = a * gcc_avg_pyy[k] + b * (yr * yr + yi * yi);
+
+    gcc_avg[2u * k] = gr;
+    gcc_avg[2u * k + 1u] = gi;
+    gcc_avg_pxx[k] = pxx;
+    gcc_avg_pyy[k] = pyy;
+
+    float w = gcc_weight_bin(gr, gi, pxx, pyy);
+    gcc_buf_x[2u * k] = gr * w;
+    gcc_buf_x[2u * k + 1u] = gi * w;
+  }
+
+  fft_real_inverse(gcc_buf_x, nfft);
+  gcc_extract(gcc_buf_x, nfft, max_lag, corr);
+}
+
+/**
+ * @brief 帧间平均 GCC-PHAT 估计 lag
+ */
+int32_t doa_estimate_lag_gcc_phat_avg(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
+{
+  if (max_lag > DOA_CORR_MAX_LAG)
+    max_lag = DOA_CORR_MAX_LAG;
+
+  doa_gcc_phat_avg_corr(x, y, n, max_lag, gcc_corr);
+  return doa_corr_argmax(gcc_corr, max_lag);
+}
+
+/**
+ * @brief 设置频域加权方式(beta 仅 PHAT-beta 使用)
+ */
+int doa_gcc_set_weighting(uint8_t weighting, float beta)
+{
+  if (weighting >= GCC_W_COUNT)
+    return -1;
+
+  gcc_weighting = weighting;
+  if (beta > 0.0f && beta <= 1.0f)
+    gcc_beta = beta;
+  return 0;
+}
+
+/**
+ * @brief 当前加权方式
+ */
+uint8_t doa_gcc_get_weighting(void)
+{
+  return gcc_weighting;
+}
+
+/**
+ * @brief 频点 k 的互谱 conj(X) Y
+ */
+static inline void gcc_bin_cross(const float *xf, const float *yf, uint32_t k, float *gr, float *gi)
+{
+  float xr = xf[2u * k];
+  float xi = xf[2u * k + 1u];
+  float yr = yf[2u * k];
+  float yi = yf[2u * k + 1u];
+  *gr = xr * yr + xi * yi;
+  *gi = xr * yi - xi * yr;
+}
+
+/**
+ * @brief 相位斜率法: 互谱相位逐频点解缠后加权最小二乘拟合斜率
+ * y[i + lag] ~ x[i] 时 arg(conj(X) Y) = -w * lag, w = 2*pi*k/nfft
+ * 只用 1..k_max 频点(k_max 以上空间混叠),且 |G| 低于带内最大值 GCC_SLOPE_MIN_REL 倍的
+ * 频点不参与(窄带信号的泄漏旁瓣相位不随频率变化,会把斜率拉偏);权重取 |G|,直线过原点
+ * fit: 加权相位一致度 [0, 1],1 = 所有频点都在拟合直线上;可为 0
+ * 返回 0 成功, -1 频带内无能量
+ */
+int gcc_phase_slope(const float *xf, const float *yf, uint32_t nfft, uint32_t k_max, float *lag, float *fit)
+{
+  if (k_max > nfft / 2u - 1u)
+    k_max = nfft / 2u - 1u;
+
+  float gr, gi;
+  float g2_max = 0.0f;
+  for (uint32_t k = 1; k <= k_max; k++)
+  {
+    gcc_bin_cross(xf, yf, k, &gr, &gi);
+    float g2 = gr * gr + gi * gi;
+    if (g2 > g2_max)
+      g2_max = g2;
+  }
+  if (g2_max <= 1e-24f)
+    return -1;
+
+  float g2_min = g2_max * (GCC_SLOPE_MIN_REL * GCC_SLOPE_MIN_REL);
+  float w_step = 2.0f * GCC_PI / (float)nfft;
+  float num = 0.0f;
+  float den = 0.0f;
+  float wsum = 0.0f;
+
+  for (uint32_t k = 1; k <= k_max; k++)
+  {
+    gcc_bin_cross(xf, yf, k, &gr, &gi);
+    float g2 = gr * gr + gi * gi;
+    if (g2 < g2_min)
+      continue;
+
+    // 解缠: 以已拟合的斜率预测本频点相位,取与预测最近的 2*pi 分支
+    float w = w_step * (float)k;
+    float pred = (den > 0.0f) ? (w * num / den) : 0.0f;
+    float d = atan2f(gi, gr) - pred;
+    while (d > GCC_PI)
+      d -= 2.0f * GCC_PI;
+    while (d < -GCC_PI)
+      d += 2.0f * GCC_PI;
+    float ph = pred + d;
+
+    float mag = sqrtf(g2);
+    num += mag * w * ph;
+    den += mag * w * w;
+    wsum += mag;
+  }
+
+  float tau = -num / den;
+  *lag = tau;
+
+  if (fit != 0)
+  {
+    // 对齐到零相位后的加权平均单位矢量长度
+    float cr = 0.0f;
+    float ci = 0.0f;
+    for (uint32_t k = 1; k <= k_max; k++)
+    {
+      gcc_bin_cross(xf, yf, k, &gr, &gi);
+      if (gr * gr + gi * gi < g2_min)
+        continue;
+
+      float a = w_step * (float)k * tau;
+      float c = cosf(a);
+      float sn = sinf(a);
+      cr += gr * c - gi * sn;
+      ci += gr * sn + gi * c;
+    }
+    *fit = sqrtf(cr * cr + ci * ci) / wsum;
+  }
+  return 0;
+}
+
+/**
+ * @brief 相位斜率模式: 在原地加权前用本帧的两路频谱求斜率(不做额外变换)
+ * 超出 +-max_lag 时限幅;频带内无能量时本帧无结果
+ */
+static void gcc_slope_update(uint32_t nfft, int32_t max_lag)
+{
+  gcc_slope_valid = 0;
+  if (!gcc_slope_on)
+    return;
+
+  uint32_t k_max = (uint32_t)(GCC_SLOPE_F_MAX_HZ * (float)nfft / FS_HZ);
+  float lag;
+  if (gcc_phase_slope(gcc_buf_x, gcc_buf_y, nfft, k_max, &lag, &gcc_slope_fit) != 0)
+    return;
+
+  if (lag > (float)max_lag)
+    lag = (float)max_lag;
+  if (lag < -(float)max_lag)
+    lag = -(float)max_lag;
+
+  float lag_f = lag * (float)DOA_Q16_ONE;
+  gcc_slope_q16 = (int32_t)(lag_f + ((lag_f >= 0.0f) ? 0.5f : -0.5f));
+  gcc_slope_valid = 1;
+}
+
+/**
+ * @brief 开关相位斜率模式(两条 GCC 路径共用)
+ */
+void doa_gcc_set_phase_slope(uint8_t on)
+{
+  gcc_slope_on = (on != 0u);
+  gcc_slope_valid = 0;
+}
+
+/**
+ * @brief 相位斜率模式是否开启
+ */
+uint8_t doa_gcc_get_phase_slope(void)
+{
+  return gcc_slope_on;
+}
+
+/**
+ * @brief 取走最近一帧的相位斜率 lag(Q16.16)与一致度,取后清除;lag_q16 / fit 可为 0
+ * 返回 0 成功, -1 本帧无结果(模式关闭、非 GCC 后端或频带内无能量)
+ */
+int doa_gcc_take_slope(int32_t *lag_q16, float *fit)
+{
+  if (!gcc_slope_valid)
+    return -1;
+
+  gcc_slope_valid = 0;
+  if (lag_q16 != 0)
+    *lag_q16 = gcc_slope_q16;
+  if (fit != 0)
+    *fit = gcc_slope_fit;
   return 0;
 }
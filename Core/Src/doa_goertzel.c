@@ -0,0 +1,155 @@
+#include "doa_goertzel.h"
+#include "doa_peak.h"
+#include <math.h>
+#include <stdint.h>
+
+#define GOERTZEL_PI 3.14159265358979f
+
+// 各音调: 数字角频率 / 递推系数 2cos(w) / 输出旋转 cos(w), sin(w)
+static uint32_t gz_n_tones = 0;
+static float gz_w[DOA_GOERTZEL_MAX_TONES];
+static float gz_coeff[DOA_GOERTZEL_MAX_TONES];
+static float gz_cos[DOA_GOERTZEL_MAX_TONES];
+static float gz_sin[DOA_GOERTZEL_MAX_TONES];
+
+/**
+ * @brief 配置音调
+ */
+int doa_goertzel_init(const float *freq_hz, uint32_t n_tones, float fs_hz)
+{
+  gz_n_tones = 0;
+  if (n_tones > DOA_GOERTZEL_MAX_TONES)
+    return -1;
+
+  for (uint32_t t = 0; t < n_tones; t++)
+  {
+    if (freq_hz[t] <= 0.0f || freq_hz[t] >= 0.5f * fs_hz)
+      return -1;
+
+    float w = 2.0f * GOERTZEL_PI * freq_hz[t] / fs_hz;
+    gz_w[t] = w;
+    gz_coeff[t] = 2.0f * cosf(w);
+    gz_cos[t] = cosf(w);
+    gz_sin[t] = sinf(w);
+  }
+
+  gz_n_tones = n_tones;
+  return 0;
+}
+
+/**
+ * @brief 当前音调数
+ */
+uint32_t doa_goertzel_tones(void)
+{
+  return gz_n_tones;
+}
+
+/**
+ * @brief 单路 Goertzel: 每采样 1 乘 2 加,返回 DFT 在 w 处的复数值
+ */
+static void gz_run(const int16_t *x, uint32_t n, uint32_t t, float *re, float *im)
+{
+  float c = gz_coeff[t];
+  float s1 = 0.0f;
+  float s2 = 0.0f;
+
+  for (uint32_t i = 0; i < n; i++)
+  {
+    float s0 = (float)x[i] + c * s1 - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+
+  *re = s1 - s2 * gz_cos[t];
+  *im = s2 * gz_sin[t];
+}
+
+/**
+ * @brief 单帧估计
+ * y[i + lag] ~ x[i] 时 arg(conj(X) Y) = -w * lag;
+ * 按频率从低到高处理,高于空间混叠频率的音调相位有 2*pi 模糊,
+ * 取与低频音调已得结果最接近的分支;最后按 |G| 加权平均
+ */
+float doa_goertzel_estimate(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, int32_t *lag_q16)
+{
+  *lag_q16 = 0;
+  if (gz_n_tones == 0u || n == 0u)
+    return 0.0f;
+
+  // 帧能量(纯度归一化用)
+  float ex = 0.0f;
+  float ey = 0.0f;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    float a = (float)x[i];
+    float b = (float)y[i];
+    ex += a * a;
+    ey += b * b;
+  }
+  if (ex <= 0.0f || ey <= 0.0f)
+    return 0.0f;
+
+  // 低频优先(无模糊的先定方向)
+  uint8_t order[DOA_GOERTZEL_MAX_TONES];
+  for (uint32_t t = 0; t < gz_n_tones; t++)
+  {
+    uint32_t j = t;
+    while (j > 0u && gz_w[order[j - 1u]] > gz_w[t])
+    {
+      order[j] = order[j - 1u];
+      j--;
+    }
+    order[j] = (uint8_t)t;
+  }
+
+  float acc = 0.0f;
+  float wsum = 0.0f;
+  float px = 0.0f;
+  float py = 0.0f;
+  for (uint32_t k = 0; k < gz_n_tones; k++)
+  {
+    uint32_t t = order[k];
+    float xr, xi, yr, yi;
+    gz_run(x, n, t, &xr, &xi);
+    gz_run(y, n, t, &yr, &yi);
+
+    float gr = xr * yr + xi * yi;
+    float gi = xr * yi - xi * yr;
+    float mag = sqrtf(gr * gr + gi * gi);
+    if (mag <= 0.0f)
+      continue;
+
+    px += xr * xr + xi * xi;
+    py += yr * yr + yi * yi;
+
+    // 主值分支,再按已有估计选择 2*pi/w 的整数倍偏移
+    float w = gz_w[t];
+    float lag = -atan2f(gi, gr) / w;
+    float period = 2.0f * GOERTZEL_PI / w;
+    if (wsum > 0.0f)
+    {
+      float ref = acc / wsum;
+      lag += period * floorf((ref - lag) / period + 0.5f);
+    }
+
+    acc += mag * lag;
+    wsum += mag;
+  }
+
+  if (wsum <= 0.0f)
+    return 0.0f;
+
+  float lag = acc / wsum;
+  if (lag > (float)max_lag)
+    lag = (float)max_lag;
+  if (lag < -(float)max_lag)
+    lag = -(float)max_lag;
+
+  float lag_f = lag * (float)DOA_Q16_ONE;
+  *lag_q16 = (int32_t)(lag_f + ((lag_f >= 0.0f) ? 0.5f : -0.5f));
+
+  // 纯音时 |X|^2 = (A n / 2)^2, sum(x^2) = n A^2 / 2,比值 2|X|^2 / (n sum(x^2)) = 1
+  float pur = 2.0f * sqrtf((px / ex) * (py / ey)) / (float)n;
+  return (pur > 1.0f) ? 1.0f : pur;
+}
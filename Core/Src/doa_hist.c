@@ -0,0 +1,116 @@
+#include "doa_hist.h"
+#include "doa_peak.h"
+#include <stdint.h>
+
+// 惰性衰减: 格中存的是 真实权重 * hist_scale,每帧只放大 hist_scale,超过上限时统一缩回
+#define HIST_SCALE_MAX 1e6f
+
+// 配置
+static int32_t hist_max_lag = 16;
+static int32_t hist_half = 16 * DOA_HIST_RES; // 中心格下标
+static float hist_inv_decay = 1.0f / 0.95f;
+
+// 直方图 / 总权重 / 众数格
+static float hist_bin[DOA_HIST_BINS];
+static float hist_total = 0.0f;
+static float hist_scale = 1.0f;
+static int32_t hist_mode = -1;
+
+/**
+ * @brief 初始化
+ */
+int doa_hist_init(int32_t max_lag, float decay)
+{
+  if (max_lag < 1 || max_lag > DOA_HIST_MAX_LAG)
+    return -1;
+  if (decay <= 0.0f || decay >= 1.0f)
+    return -1;
+
+  hist_max_lag = max_lag;
+  hist_half = max_lag * DOA_HIST_RES;
+  hist_inv_decay = 1.0f / decay;
+  doa_hist_reset();
+  return 0;
+}
+
+/**
+ * @brief 清空
+ */
+void doa_hist_reset(void)
+{
+  for (uint32_t i = 0; i < DOA_HIST_BINS; i++)
+    hist_bin[i] = 0.0f;
+  hist_total = 0.0f;
+  hist_scale = 1.0f;
+  hist_mode = -1;
+}
+
+/**
+ * @brief 单格累加,同时维护众数(衰减对所有格等比例,不改变大小顺序)
+ */
+static inline void hist_add(int32_t idx, float w)
+{
+  hist_bin[idx] += w;
+  if (hist_mode < 0 || hist_bin[idx] > hist_bin[hist_mode])
+    hist_mode = idx;
+}
+
+/**
+ * @brief 每帧更新
+ */
+void doa_hist_update(int32_t lag_q16, float weight)
+{
+  hist_scale *= hist_inv_decay;
+  if (hist_scale > HIST_SCALE_MAX)
+  {
+    float k = 1.0f / hist_scale;
+    for (int32_t i = 0; i <= 2 * hist_half; i++)
+      hist_bin[i] *= k;
+    hist_total *= k;
+    hist_scale = 1.0f;
+  }
+
+  if (weight <= 0.0f)
+    return;
+
+  // lag -> 格坐标(Q16),限幅到范围内
+  int32_t lim = hist_max_lag * DOA_Q16_ONE;
+  if (lag_q16 < -lim)
+    lag_q16 = -lim;
+  if (lag_q16 > lim)
+    lag_q16 = lim;
+
+  int64_t pos = (int64_t)(lag_q16 + lim) * DOA_HIST_RES;
+  int32_t idx = (int32_t)(pos >> 16);
+  float frac = (float)(pos & 0xFFFF) * (1.0f / (float)DOA_Q16_ONE);
+
+  float w = weight * hist_scale;
+  hist_total += w;
+  hist_add(idx, w * (1.0f - frac));
+  if (frac > 0.0f)
+    hist_add(idx + 1, w * frac);
+}
+
+/**
+ * @brief 主导 lag
+ */
+int32_t doa_hist_mode_q16(void)
+{
+  if (hist_mode < 0)
+    return 0;
+
+  // 直方图与相关函数缓冲区同样是以中心对称排列,直接复用三点插值
+  float off = doa_corr_interp(hist_bin, hist_half, hist_mode - hist_half);
+  float lag_f = ((float)(hist_mode - hist_half) + off) * ((float)DOA_Q16_ONE / (float)DOA_HIST_RES);
+  return (int32_t)(lag_f + ((lag_f >= 0.0f) ? 0.5f : -0.5f));
+}
+
+/**
+ * @brief 众数集中度
+ */
+float doa_hist_strength(void)
+{
+  if (hist_mode < 0 || hist_total <= 0.0f)
+    return 0.0f;
+  return hist_bin[hist_mode] / hist_total;
+}
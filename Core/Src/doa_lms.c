@@ -0,0 +1,135 @@
+#include "doa_lms.h"
+#include "doa_peak.h"
+#include <stdint.h>
+
+#define LMS_MAX_TAPS (2 * DOA_LMS_MAX_LAG + 1)
+
+// NLMS 正则项,防止静音时步长发散
+#define LMS_EPS 1.0f
+
+// 配置
+static int32_t lms_max_lag = 16;
+static uint32_t lms_taps = 33u;
+static float lms_mu = DOA_LMS_MU;
+
+// 抽头权重: w[lag + max_lag]
+static float lms_w[LMS_MAX_TAPS];
+
+// x 延迟线(双倍长度,窗口始终连续,内循环不取模)
+static float lms_xbuf[2 * LMS_MAX_TAPS];
+static uint32_t lms_xpos = 0;
+static int64_t lms_xpow = 0; // 窗内能量(整数累加,不漂移)
+
+// y 延迟 max_lag 个采样作为期望信号(使负 lag 也是因果的)
+static int16_t lms_ybuf[DOA_LMS_MAX_LAG];
+static uint32_t lms_ypos = 0;
+
+// 去直流状态(Q8)
+static int32_t lms_dc_x = 0;
+static int32_t lms_dc_y = 0;
+static uint32_t lms_warm = 0;
+
+/**
+ * @brief 初始化
+ */
+int doa_lms_init(int32_t max_lag, float mu)
+{
+  if (max_lag < 1 || max_lag > DOA_LMS_MAX_LAG)
+    return -1;
+  if (mu <= 0.0f || mu >= 2.0f)
+    return -1;
+
+  lms_max_lag = max_lag;
+  lms_taps = (uint32_t)(2 * max_lag + 1);
+  lms_mu = mu;
+  doa_lms_reset();
+  return 0;
+}
+
+/**
+ * @brief 清空权重与延迟线
+ */
+void doa_lms_reset(void)
+{
+  for (uint32_t i = 0; i < LMS_MAX_TAPS; i++)
+    lms_w[i] = 0.0f;
+  for (uint32_t i = 0; i < 2u * LMS_MAX_TAPS; i++)
+    lms_xbuf[i] = 0.0f;
+  for (uint32_t i = 0; i < DOA_LMS_MAX_LAG; i++)
+    lms_ybuf[i] = 0;
+
+  lms_xpos = 0;
+  lms_ypos = 0;
+  lms_xpow = 0;
+  lms_warm = 0;
+}
+
+/**
+ * @brief 逐采样 NLMS 更新
+ * 输入 u = [x[n], x[n-1], ..., x[n-2L]],期望 d = y[n-L]
+ * y[n-L] ~ x[n-L-lag] 落在抽头 L+lag 上,故 w[lag + L] 的峰即 lag
+ */
+void doa_lms_push(int16_t x, int16_t y)
+{
+  // 首个采样直接作为直流初值,避免上电长时间收敛
+  if (lms_warm == 0u)
+  {
+    lms_dc_x = (int32_t)x << 8;
+    lms_dc_y = (int32_t)y << 8;
+    lms_warm = 1u;
+  }
+  lms_dc_x += (((int32_t)x << 8) - lms_dc_x) >> DOA_LMS_DC_SHIFT;
+  lms_dc_y += (((int32_t)y << 8) - lms_dc_y) >> DOA_LMS_DC_SHIFT;
+  int32_t xi = x - (lms_dc_x >> 8);
+  float xv = (float)xi;
+  int16_t yv = (int16_t)(y - (lms_dc_y >> 8));
+
+  // x 延迟线: 新采样写在窗口头部,窗口 u[k] = xbuf[pos + k]
+  lms_xpos = (lms_xpos == 0u) ? (lms_taps - 1u) : (lms_xpos - 1u);
+  int32_t old = (int32_t)lms_xbuf[lms_xpos + lms_taps];
+  lms_xbuf[lms_xpos] = xv;
+  lms_xbuf[lms_xpos + lms_taps] = xv;
+  lms_xpow += (int64_t)xi * xi - (int64_t)old * old;
+
+  // y 延迟 L 个采样
+  float d = (float)lms_ybuf[lms_ypos];
+  lms_ybuf[lms_ypos] = yv;
+  lms_ypos++;
+  if (lms_ypos >= (uint32_t)lms_max_lag)
+    lms_ypos = 0;
+
+  const float *u = &lms_xbuf[lms_xpos];
+  float est = 0.0f;
+  for (uint32_t k = 0; k < lms_taps; k++)
+    est += lms_w[k] * u[k];
+
+  float g = lms_mu * (d - est) / ((float)lms_xpow + LMS_EPS);
+  for (uint32_t k = 0; k < lms_taps; k++)
+    lms_w[k] += g * u[k];
+}
+
+/**
+ * @brief 权重峰值 lag(Q16.16,三点插值)
+ */
+int32_t doa_lms_lag_q16(void)
+{
+  int32_t lag = doa_corr_argmax(lms_w, lms_max_lag);
+  float lag_f = ((float)lag + doa_corr_interp(lms_w, lms_max_lag, lag)) * (float)DOA_Q16_ONE;
+  return (int32_t)(lag_f + ((lag_f >= 0.0f) ? 0.5f : -0.5f));
+}
+
+/**
+ * @brief 峰值权重
+ */
+float doa_lms_peak(void)
+{
+  return lms_w[doa_corr_argmax(lms_w, lms_max_lag) + lms_max_lag];
+}
+
+/**
+ * @brief 抽头权重
+ */
+const float *doa_lms_weights(void)
+{
+  return lms_w;
+}
@@ -0,0 +1,340 @@
+#include "doa_music.h"
+#include "dsp_fft.h"
+#include <math.h>
+#include <stdint.h>
+
+#define MUSIC_PI 3.14159265358979f
+#define MUSIC_DIM (2u * MUSIC_MAX_MICS) // 复 Hermitian 矩阵的实对称嵌入维度
+#define MUSIC_JACOBI_SWEEPS 12u
+
+// 配置
+static doa_music_cfg_t music_cfg;
+static uint8_t music_ready = 0;
+
+// 频点(FFT bin 下标)
+static uint16_t music_bin[MUSIC_MAX_BINS];
+
+// 空间协方差 R = A + iB,按频点递推更新
+static float music_cov_re[MUSIC_MAX_BINS][MUSIC_MAX_MICS][MUSIC_MAX_MICS];
+static float music_cov_im[MUSIC_MAX_BINS][MUSIC_MAX_MICS][MUSIC_MAX_MICS];
+static uint32_t music_frames = 0;
+
+// 导向矢量 a_m = exp(-i*2*pi*f*tau_m): 初始化时算好第一个频点的值与相邻 FFT bin 间的旋转因子
+// exp(-i*2*pi*df*tau_m),扫描时逐频点复数相乘递推(频点升序),扫描中不做三角函数
+static float music_a0_re[MUSIC_MAX_GRID][MUSIC_MAX_MICS];
+static float music_a0_im[MUSIC_MAX_GRID][MUSIC_MAX_MICS];
+static float music_rot_re[MUSIC_MAX_GRID][MUSIC_MAX_MICS];
+static float music_rot_im[MUSIC_MAX_GRID][MUSIC_MAX_MICS];
+
+// 扫描时的当前频点导向矢量
+static float music_a_re[MUSIC_MAX_GRID][MUSIC_MAX_MICS];
+static float music_a_im[MUSIC_MAX_GRID][MUSIC_MAX_MICS];
+
+// 伪谱
+static float music_spec[MUSIC_MAX_GRID];
+
+// FFT 工作区(各通道依次复用)
+static float music_fft_buf[MUSIC_MAX_NFFT];
+
+/**
+ * @brief 初始化
+ */
+int doa_music_init(const doa_music_cfg_t *cfg)
+{
+  const doa_array_t *arr = cfg->array;
+
+  music_ready = 0;
+  if (arr == 0 || arr->num_mics < 2u || arr->num_mics > MUSIC_MAX_MICS)
+    return -1;
+  if (cfg->num_sources == 0u || cfg->num_sources >= arr->num_mics)
+    return -1;
+  if (cfg->num_bins == 0u || cfg->num_bins > MUSIC_MAX_BINS)
+    return -1;
+  if (cfg->grid_n == 0u || cfg->grid_n > MUSIC_MAX_GRID)
+    return -1;
+  if (fft_size_for(cfg->nfft) != cfg->nfft || cfg->nfft > MUSIC_MAX_NFFT)
+    return -1;
+  // 导向矢量按频点升序递推
+  if (cfg->num_bins > 1u && cfg->f_hi_hz < cfg->f_lo_hz)
+    return -1;
+
+  music_cfg = *cfg;
+
+  // 频点在 [f_lo, f_hi] 内均匀取
+  float df = cfg->fs_hz / (float)cfg->nfft;
+  for (uint32_t b = 0; b < cfg->num_bins; b++)
+  {
+    float f = cfg->f_lo_hz;
+    if (cfg->num_bins > 1u)
+      f += (cfg->f_hi_hz - cfg->f_lo_hz) * (float)b / (float)(cfg->num_bins - 1u);
+
+    uint32_t k = (uint32_t)(f / df + 0.5f);
+    if (k < 1u)
+      k = 1u;
+    if (k > cfg->nfft / 2u - 1u)
+      k = cfg->nfft / 2u - 1u;
+    music_bin[b] = (uint16_t)k;
+  }
+
+  float w0 = 2.0f * MUSIC_PI * df * (float)music_bin[0];
+  float w1 = 2.0f * MUSIC_PI * df;
+  for (uint32_t g = 0; g < cfg->grid_n; g++)
+  {
+    float az = (cfg->az_start_deg + cfg->az_step_deg * (float)g) * (MUSIC_PI / 180.0f);
+    float s = sinf(az);
+    float c = cosf(az);
+    for (uint32_t m = 0; m < arr->num_mics; m++)
+    {
+      float tau = doa_array_delay_s(arr, m, s, c);
+      music_a0_re[g][m] = cosf(w0 * tau);
+      music_a0_im[g][m] = -sinf(w0 * tau);
+      music_rot_re[g][m] = cosf(w1 * tau);
+      music_rot_im[g][m] = -sinf(w1 * tau);
+    }
+  }
+
+  music_frames = 0;
+  music_ready = 1;
+  return 0;
+}
+
+/**
+ * @brief 每帧更新协方差: R = forget * R + (1 - forget) * x x^H
+ * 每帧代价 O(麦克风数 * FFT + 频点数 * 麦克风数^2),与运行时长无关
+ */
+void doa_music_update(const int16_t *const ch[], uint32_t n)
+{
+  if (!music_ready)
+    return;
+
+  uint32_t nfft = music_cfg.nfft;
+  uint32_t nm = music_cfg.array->num_mics;
+  uint32_t nb = music_cfg.num_bins;
+  float snap_re[MUSIC_MAX_BINS][MUSIC_MAX_MICS];
+  float snap_im[MUSIC_MAX_BINS][MUSIC_MAX_MICS];
+
+  if (n > nfft)
+    n = nfft;
+
+  for (uint32_t m = 0; m < nm; m++)
+  {
+    for (uint32_t i = 0; i < n; i++)
+      music_fft_buf[i] = (float)ch[m][i];
+    for (uint32_t i = n; i < nfft; i++)
+      music_fft_buf[i] = 0.0f;
+
+    fft_real_forward(music_fft_buf, nfft);
+
+    for (uint32_t b = 0; b < nb; b++)
+    {
+      snap_re[b][m] = music_fft_buf[2u * music_bin[b]];
+      snap_im[b][m] = music_fft_buf[2u * music_bin[b] + 1u];
+    }
+  }
+
+  // 首帧直接赋值,之后指数平均
+  float a = (music_frames == 0u) ? 0.0f : music_cfg.forget;
+  float w = 1.0f - a;
+
+  for (uint32_t b = 0; b < nb; b++)
+  {
+    for (uint32_t i = 0; i < nm; i++)
+    {
+      for (uint32_t j = 0; j < nm; j++)
+      {
+        // x_i * conj(x_j)
+        float pr = snap_re[b][i] * snap_re[b][j] + snap_im[b][i] * snap_im[b][j];
+        float pi = snap_im[b][i] * snap_re[b][j] - snap_re[b][i] * snap_im[b][j];
+        music_cov_re[b][i][j] = a * music_cov_re[b][i][j] + w * pr;
+        music_cov_im[b][i][j] = a * music_cov_im[b][i][j] + w * pi;
+      }
+    }
+  }
+
+  music_frames++;
+}
+
+/**
+ * @brief 实对称矩阵 Jacobi 特征分解,a 被对角化,v 的列为特征向量
+ */
+static void music_jacobi(float a[MUSIC_DIM][MUSIC_DIM], float v[MUSIC_DIM][MUSIC_DIM], uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    for (uint32_t j = 0; j < n; j++)
+      v[i][j] = (i == j) ? 1.0f : 0.0f;
+
+  float diag = 0.0f;
+  for (uint32_t i = 0; i < n; i++)
+    diag += a[i][i] * a[i][i];
+
+  for (uint32_t sweep = 0; sweep < MUSIC_JACOBI_SWEEPS; sweep++)
+  {
+    float off = 0.0f;
+    for (uint32_t p = 0; p < n; p++)
+      for (uint32_t q = p + 1u; q < n; q++)
+        off += a[p][q] * a[p][q];
+
+    if (off <= 1e-12f * diag)
+      break;
+
+    for (uint32_t p = 0; p < n; p++)
+    {
+      for (uint32_t q = p + 1u; q < n; q++)
+      {
+        float apq = a[p][q];
+        if (fabsf(apq) <= 1e-20f)
+          continue;
+
+        float theta = (a[q][q] - a[p][p]) / (2.0f * apq);
+        float t = 1.0f / (fabsf(theta) + sqrtf(theta * theta + 1.0f));
+        if (theta < 0.0f)
+          t = -t;
+        float c = 1.0f / sqrtf(t * t + 1.0f);
+        float s = t * c;
+
+        for (uint32_t k = 0; k < n; k++)
+        {
+          float akp = a[k][p];
+          float akq = a[k][q];
+          a[k][p] = c * akp - s * akq;
+          a[k][q] = s * akp + c * akq;
+        }
+        for (uint32_t k = 0; k < n; k++)
+        {
+          float apk = a[p][k];
+          float aqk = a[q][k];
+          a[p][k] = c * apk - s * aqk;
+          a[q][k] = s * apk + c * aqk;
+        }
+        for (uint32_t k = 0; k < n; k++)
+        {
+          float vkp = v[k][p];
+          float vkq = v[k][q];
+          v[k][p] = c * vkp - s * vkq;
+          v[k][q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief 特征分解 + 方位扫描
+ * 复 Hermitian R = A + iB 嵌入为实对称 [[A, -B], [B, A]],特征值成对出现,
+ * 最小的 2*(M-S) 个特征向量张成噪声子空间;宽带时对各频点的投影能量求和
+ */
+float doa_music_estimate(void)
+{
+  if (!music_ready || music_frames == 0u)
+    return 0.0f;
+
+  uint32_t nm = music_cfg.array->num_mics;
+  uint32_t dim = 2u * nm;
+  uint32_t nnoise = 2u * (nm - music_cfg.num_sources);
+  uint32_t grid_n = music_cfg.grid_n;
+
+  for (uint32_t g = 0; g < grid_n; g++)
+  {
+    music_spec[g] = 0.0f;
+    for (uint32_t m = 0; m < nm; m++)
+    {
+      music_a_re[g][m] = music_a0_re[g][m];
+      music_a_im[g][m] = music_a0_im[g][m];
+    }
+  }
+
+  for (uint32_t b = 0; b < music_cfg.num_bins; b++)
+  {
+    float a[MUSIC_DIM][MUSIC_DIM];
+    float v[MUSIC_DIM][MUSIC_DIM];
+
+    for (uint32_t i = 0; i < nm; i++)
+    {
+      for (uint32_t j = 0; j < nm; j++)
+      {
+        float re = music_cov_re[b][i][j];
+        float im = music_cov_im[b][i][j];
+        a[i][j] = re;
+        a[i][j + nm] = -im;
+        a[i + nm][j] = im;
+        a[i + nm][j + nm] = re;
+      }
+    }
+
+    music_jacobi(a, v, dim);
+
+    // 选出最小的 nnoise 个特征值对应的列
+    uint8_t noise_col[MUSIC_DIM];
+    uint8_t used[MUSIC_DIM] = {0};
+    for (uint32_t k = 0; k < nnoise; k++)
+    {
+      uint32_t best = 0;
+      float best_ev = 0.0f;
+      uint8_t found = 0;
+      for (uint32_t i = 0; i < dim; i++)
+      {
+        if (!used[i] && (!found || a[i][i] < best_ev))
+        {
+          best = i;
+          best_ev = a[i][i];
+          found = 1;
+        }
+      }
+      used[best] = 1;
+      noise_col[k] = (uint8_t)best;
+    }
+
+    // 导向矢量在噪声子空间上的投影能量;从上一个频点旋转 (bin_b - bin_{b-1}) 次得到本频点
+    uint32_t steps = (b > 0u) ? (uint32_t)(music_bin[b] - music_bin[b - 1u]) : 0u;
+    for (uint32_t g = 0; g < grid_n; g++)
+    {
+      float *sr = music_a_re[g];
+      float *si = music_a_im[g];
+      for (uint32_t m = 0; m < nm; m++)
+      {
+        for (uint32_t t = 0; t < steps; t++)
+        {
+          float re = sr[m] * music_rot_re[g][m] - si[m] * music_rot_im[g][m];
+          float im = sr[m] * music_rot_im[g][m] + si[m] * music_rot_re[g][m];
+          sr[m] = re;
+          si[m] = im;
+        }
+      }
+
+      float d = 0.0f;
+      for (uint32_t k = 0; k < nnoise; k++)
+      {
+        uint32_t col = noise_col[k];
+        float proj = 0.0f;
+        for (uint32_t m = 0; m < nm; m++)
+          proj += v[m][col] * sr[m] + v[m + nm][col] * si[m];
+        d += proj * proj;
+      }
+      music_spec[g] += d;
+    }
+  }
+
+  // 伪谱 = 1 / 噪声子空间投影能量,取峰
+  uint32_t best_g = 0;
+  float best = -1.0f;
+  for (uint32_t g = 0; g < grid_n; g++)
+  {
+    float p = 1.0f / (music_spec[g] / (float)(music_cfg.num_bins * nm) + 1e-9f);
+    music_spec[g] = p;
+    if (p > best)
+    {
+      best = p;
+      best_g = g;
+    }
+  }
+
+  return music_cfg.az_start_deg + music_cfg.az_step_deg * (float)best_g;
+}
+
+/**
+ * @brief 最近一次扫描的伪谱
+ */
+const float *doa_music_spectrum(void)
+{
+  return music_spec;
+}
@@ -1,46 +1,420 @@
 #include "doa_ncc.h"
+#include "doa_peak.h"
+#include "dsp_xcorr.h"
 #include <math.h>
 #include <stdint.h>
 
+// lag 搜索用的相关缓冲区
+static float ncc_corr[DOA_CORR_MAX_LEN];
+
+/**
+ * @brief 单个 lag 的归一化
+ */
+static inline float ncc_normalize(int64_t sum_xy, uint64_t sum_x2, uint64_t sum_y2)
+{
+  if (sum_x2 == 0 || sum_y2 == 0)
+    return DOA_CORR_INVALID;
+
+  float denom = sqrtf((float)sum_x2 * (float)sum_y2);
+  return (float)sum_xy / denom;
+}
+
+/**
+ * @brief NCC 相关函数: corr[lag + max_lag] = sum(x*y) / sqrt(sum(x^2) * sum(y^2))
+ * 重叠区能量 = 整帧能量 - 被移出重叠区的首/尾样本能量,每个 lag O(1) 更新,
+ * 内层循环只累加互相关项
+ */
+void doa_ncc_corr(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr)
+{
+  uint64_t ex = dsp_energy_q15(x, n);
+  uint64_t ey = dsp_energy_q15(y, n);
+
+  // lag >= 0: 重叠区 x[0, n-lag), y[lag, n)
+  uint64_t tail_x = 0;
+  uint64_t head_y = 0;
+  for (int32_t lag = 0; lag <= max_lag; lag++)
+  {
+    uint32_t l = (uint32_t)lag;
+    if (l > 0u)
+    {
+      int32_t xv = x[n - l];
+      int32_t yv = y[l - 1u];
+      tail_x += (uint64_t)(xv * xv);
+      head_y += (uint64_t)(yv * yv);
+    }
+
+    int64_t sum_xy = dsp_dot_q15(x, y + l, n - l);
+    corr[lag + max_lag] = ncc_normalize(sum_xy, ex - tail_x, ey - head_y);
+  }
+
+  // lag < 0: 重叠区 x[m, n), y[0, n-m), m = -lag
+  uint64_t head_x = 0;
+  uint64_t tail_y = 0;
+  for (int32_t lag = -1; lag >= -max_lag; lag--)
+  {
+    uint32_t m = (uint32_t)(-lag);
+    int32_t xv = x[m - 1u];
+    int32_t yv = y[n - m];
+    head_x += (uint64_t)(xv * xv);
+    tail_y += (uint64_t)(yv * yv);
+
+    int64_t sum_xy = dsp_dot_q15(x + m, y, n - m);
+    corr[lag + max_lag] = ncc_normalize(sum_xy, ex - head_x, ey - tail_y);
+  }
+}
+
 /**
  * @brief NCC 归一化互相关估计 lag(抗 MAX9814 AGC 更稳)
  */
 int32_t doa_estimate_lag_ncc(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
 {
-  float best = -1e9f;
-  int32_t best_lag = 0;
+  if (max_lag > DOA_CORR_MAX_LAG)
+    max_lag = DOA_CORR_MAX_LAG;
+
+  doa_ncc_corr(x, y, n, max_lag, ncc_corr);
+  return doa_corr_argmax(ncc_corr, max_lag);
+}
+
+// ======================= 定点峰值比较 =======================
+
+// 归一化整数: v ~ m * 2^e, m 在 [2^30, 2^31)(v = 0 时 m = 0)
+typedef struct
+{
+  uint32_t m;
+  int32_t e;
+} ncc_qnum_t;
+
+// 单个 lag 的得分 sign * num / den, num = sum_xy^2, den = sum_x2 * sum_y2
+typedef struct
+{
+  int8_t sign; // 1 / 0 / -1, 重叠区能量为 0 时为 -2(最差)
+  ncc_qnum_t num;
+  ncc_qnum_t den;
+} ncc_qscore_t;
+
+/**
+ * @brief 64bit 无符号数归一化到 31bit 尾数(截断)
+ */
+static inline ncc_qnum_t ncc_q_norm(uint64_t v)
+{
+  ncc_qnum_t r = {0u, 0};
+  if (v == 0u)
+    return r;
+
+  int32_t shift = (64 - __builtin_clzll(v)) - 31;
+  r.m = (shift > 0) ? (uint32_t)(v >> shift) : (uint32_t)(v << (-shift));
+  r.e = shift;
+  return r;
+}
 
-  for (int32_t lag = -max_lag; lag <= max_lag; lag++)
+/**
+ * @brief 两个归一化数相乘(尾数乘积 < 2^62,再归一化)
+ */
+static inline ncc_qnum_t ncc_q_mul(ncc_qnum_t a, ncc_qnum_t b)
+{
+  ncc_qnum_t r = ncc_q_norm((uint64_t)a.m * b.m);
+  r.e += a.e + b.e;
+  return r;
+}
+
+/**
+ * @brief 单个 lag 的定点得分(只做乘法和移位)
+ */
+static inline ncc_qscore_t ncc_q_score(int64_t sum_xy, uint64_t sum_x2, uint64_t sum_y2)
+{
+  ncc_qscore_t s;
+  if (sum_x2 == 0 || sum_y2 == 0)
   {
-    int64_t sum_xy = 0;
-    uint64_t sum_x2 = 0;
-    uint64_t sum_y2 = 0;
+    s.sign = -2;
+    s.num = ncc_q_norm(0u);
+    s.den = s.num;
+    return s;
+  }
+
+  ncc_qnum_t a = ncc_q_norm((uint64_t)((sum_xy < 0) ? -sum_xy : sum_xy));
+  s.sign = (sum_xy > 0) ? 1 : ((sum_xy < 0) ? -1 : 0);
+  s.num = ncc_q_mul(a, a);
+  s.den = ncc_q_mul(ncc_q_norm(sum_x2), ncc_q_norm(sum_y2));
+  return s;
+}
 
-    // 只累加重叠区域
-    uint32_t i_start = (lag < 0) ? (uint32_t)(-lag) : 0u;
-    uint32_t i_end = (lag > 0) ? (n - (uint32_t)lag) : n;
+/**
+ * @brief 比较 |a| 与 |b|: num_a * den_b 对 num_b * den_a(交叉相乘,无除法/开方)
+ * 返回 1 / 0 / -1
+ */
+static int ncc_q_cmp_mag(const ncc_qscore_t *a, const ncc_qscore_t *b)
+{
+  uint64_t l = (uint64_t)a->num.m * b->den.m;
+  uint64_t r = (uint64_t)b->num.m * a->den.m;
+  int32_t el = a->num.e + b->den.e;
+  int32_t er = b->num.e + a->den.e;
+
+  // 非零乘积在 [2^60, 2^62),指数差 >= 2 时直接由指数决定
+  if (l != 0u && r != 0u)
+  {
+    if (el - er >= 2)
+      return 1;
+    if (er - el >= 2)
+      return -1;
+    if (el > er)
+      l <<= 1;
+    else if (er > el)
+      r <<= 1;
+  }
 
-    for (uint32_t i = i_start; i < i_end; i++)
+  return (l > r) ? 1 : ((l < r) ? -1 : 0);
+}
+
+/**
+ * @brief 比较两个带符号得分 a 与 b
+ */
+static int ncc_q_cmp(const ncc_qscore_t *a, const ncc_qscore_t *b)
+{
+  if (a->sign != b->sign)
+    return (a->sign > b->sign) ? 1 : -1;
+  if (a->sign == 0 || a->sign == -2)
+    return 0;
+
+  int c = ncc_q_cmp_mag(a, b);
+  return (a->sign > 0) ? c : -c;
+}
+
+// 每个 lag 的重叠区互相关/能量(定点扫描结果,峰值比较与按需归一化共用)
+typedef struct
+{
+  int64_t xy;
+  uint64_t x2;
+  uint64_t y2;
+} ncc_q_sum_t;
+
+static ncc_q_sum_t ncc_q_sums[DOA_CORR_MAX_LEN];
+
+/**
+ * @brief 定点扫描: ncc_q_sums[lag + max_lag],能量 O(1) 滑动更新(同 doa_ncc_corr)
+ */
+static void ncc_q_sweep(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
+{
+  uint64_t ex = dsp_energy_q15(x, n);
+  uint64_t ey = dsp_energy_q15(y, n);
+
+  uint64_t tail_x = 0;
+  uint64_t head_y = 0;
+  for (int32_t lag = 0; lag <= max_lag; lag++)
+  {
+    uint32_t l = (uint32_t)lag;
+    if (l > 0u)
     {
-      int32_t xi = x[i];
-      int32_t yi = y[i + lag];
-      sum_xy += (int64_t)xi * (int64_t)yi;
-      sum_x2 += (uint64_t)(xi * xi);
-      sum_y2 += (uint64_t)(yi * yi);
+      int32_t xv = x[n - l];
+      int32_t yv = y[l - 1u];
+      tail_x += (uint64_t)(xv * xv);
+      head_y += (uint64_t)(yv * yv);
     }
 
-    if (sum_x2 == 0 || sum_y2 == 0)
-      continue;
+    ncc_q_sum_t *s = &ncc_q_sums[lag + max_lag];
+    s->xy = dsp_dot_q15(x, y + l, n - l);
+    s->x2 = ex - tail_x;
+    s->y2 = ey - head_y;
+  }
+
+  uint64_t head_x = 0;
+  uint64_t tail_y = 0;
+  for (int32_t lag = -1; lag >= -max_lag; lag--)
+  {
+    uint32_t m = (uint32_t)(-lag);
+    int32_t xv = x[m - 1u];
+    int32_t yv = y[n - m];
+    head_x += (uint64_t)(xv * xv);
+    tail_y += (uint64_t)(yv * yv);
+
+    ncc_q_sum_t *s = &ncc_q_sums[lag + max_lag];
+    s->xy = dsp_dot_q15(x + m, y, n - m);
+    s->x2 = ex - head_x;
+    s->y2 = ey - tail_y;
+  }
+}
+
+/**
+ * @brief 第 i 个 lag 的定点得分
+ */
+static inline ncc_qscore_t ncc_q_score_at(int32_t i)
+{
+  const ncc_q_sum_t *s = &ncc_q_sums[i];
+  return ncc_q_score(s->xy, s->x2, s->y2);
+}
+
+/**
+ * @brief 定点 NCC 估计 lag
+ * 与 doa_estimate_lag_ncc 选同一个峰(并列时同样取最小 lag),lag 循环内无开方/除法/浮点
+ */
+int32_t doa_estimate_lag_ncc_q(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
+{
+  if (max_lag > DOA_CORR_MAX_LAG)
+    max_lag = DOA_CORR_MAX_LAG;
 
-    float denom = sqrtf((float)sum_x2 * (float)sum_y2);
-    float ncc = (float)sum_xy / denom;
+  ncc_q_sweep(x, y, n, max_lag);
 
-    if (ncc > best)
+  // lag 升序,严格大于才替换(与 doa_corr_argmax 一致);能量为 0 的 lag 无效
+  ncc_qscore_t best;
+  int32_t best_lag = 0;
+  best.sign = -2;
+  for (int32_t i = 0; i < 2 * max_lag + 1; i++)
+  {
+    ncc_qscore_t s = ncc_q_score_at(i);
+    if (s.sign != -2 && (best.sign == -2 || ncc_q_cmp(&s, &best) > 0))
     {
-      best = ncc;
-      best_lag = lag;
+      best = s;
+      best_lag = i - max_lag;
     }
   }
 
   return best_lag;
 }
+
+/**
+ * @brief 定点 NCC 相关函数: 局部极大的判定全部用定点比较,
+ * 只有局部极大及其左右邻点做浮点归一化(插值/峰旁瓣比/多峰所需),其余 lag 填 DOA_CORR_INVALID。
+ * 局部极大的定义与 doa_corr_peaks 相同,取峰/次峰/top-K 结果与 doa_ncc_corr 一致;
+ * 开方/除法次数从 2*max_lag+1 降到 3 * 局部极大数
+ */
+void doa_ncc_corr_q(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr)
+{
+  int32_t len = 2 * max_lag + 1;
+  ncc_q_sweep(x, y, n, max_lag);
+
+  for (int32_t i = 0; i < len; i++)
+    corr[i] = DOA_CORR_INVALID;
+
+  ncc_qscore_t prev;
+  ncc_qscore_t cur = ncc_q_score_at(0);
+  prev.sign = -2;
+  for (int32_t i = 0; i < len; i++)
+  {
+    ncc_qscore_t next;
+    if (i + 1 < len)
+      next = ncc_q_score_at(i + 1);
+    else
+      next.sign = -2;
+
+    // 严格大于左邻、不小于右邻(无效点比任何有效得分都小)
+    if (cur.sign != -2 && (prev.sign == -2 || ncc_q_cmp(&cur, &prev) > 0) &&
+        (next.sign == -2 || ncc_q_cmp(&cur, &next) >= 0))
+    {
+      int32_t lo = (i > 0) ? (i - 1) : i;
+      int32_t hi = (i + 1 < len) ? (i + 1) : i;
+      for (int32_t j = lo; j <= hi; j++)
+        corr[j] = ncc_normalize(ncc_q_sums[j].xy, ncc_q_sums[j].x2, ncc_q_sums[j].y2);
+    }
+
+    prev = cur;
+    cur = next;
+  }
+}
+
+// ======================= 粗到细分级搜索 =======================
+
+// 降采样缓冲区(第一级 /2 输出,第二级原地 /2)
+static int16_t c2f_x[NCC_C2F_MAX_N / 2u];
+static int16_t c2f_y[NCC_C2F_MAX_N / 2u];
+static float c2f_corr[DOA_CORR_MAX_LEN];
+
+/**
+ * @brief 半带 [1 2 1]/4 低通 + 2 倍抽取,返回输出点数
+ */
+static uint32_t ncc_halfband_decim2(const int16_t *src, int16_t *dst, uint32_t n)
+{
+  uint32_t m = n / 2u;
+  for (uint32_t k = 0; k < m; k++)
+  {
+    uint32_t i = 2u * k;
+    int32_t prev = (i > 0u) ? src[i - 1u] : src[i];
+    int32_t next = (i + 1u < n) ? src[i + 1u] : src[i];
+    dst[k] = (int16_t)((prev + 2 * (int32_t)src[i] + next) >> 2);
+  }
+  return m;
+}
+
+/**
+ * @brief 全速率下单个 lag 的 NCC(重叠区能量由整帧能量减去边缘样本得到)
+ */
+static float ncc_score_lag(const int16_t *x, const int16_t *y, uint32_t n, int32_t lag,
+                           uint64_t ex, uint64_t ey)
+{
+  uint32_t m = (uint32_t)((lag < 0) ? -lag : lag);
+  uint64_t cut_x = 0;
+  uint64_t cut_y = 0;
+
+  for (uint32_t i = 0; i < m; i++)
+  {
+    // lag > 0 去掉 x 尾部/y 头部,lag < 0 去掉 x 头部/y 尾部
+    int32_t xv = (lag > 0) ? x[n - 1u - i] : x[i];
+    int32_t yv = (lag > 0) ? y[i] : y[n - 1u - i];
+    cut_x += (uint64_t)(xv * xv);
+    cut_y += (uint64_t)(yv * yv);
+  }
+
+  int64_t sum_xy = (lag >= 0) ? dsp_dot_q15(x, y + m, n - m) : dsp_dot_q15(x + m, y, n - m);
+  return ncc_normalize(sum_xy, ex - cut_x, ey - cut_y);
+}
+
+/**
+ * @brief 粗到细 NCC 相关函数
+ * 两级半带抽取(/4)后在粗网格上取前 NCC_C2F_PEAKS 个峰(非极大值抑制),再只在每个
+ * 4*粗峰 附近 +-NCC_C2F_REFINE 的全速率 lag 上精算;主峰以外的窗口给出真实旁瓣,
+ * 峰旁瓣比/多峰提取与全 lag NCC 一致。未精算的 lag 填 DOA_CORR_INVALID
+ */
+void doa_ncc_corr_c2f(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag, float *corr)
+{
+  if (n > NCC_C2F_MAX_N)
+    n = NCC_C2F_MAX_N;
+
+  // 粗搜索: /2 -> /2,复用输出缓冲区做中间级
+  uint32_t nd = ncc_halfband_decim2(x, c2f_x, n);
+  (void)ncc_halfband_decim2(y, c2f_y, n);
+  nd = ncc_halfband_decim2(c2f_x, c2f_x, nd);
+  (void)ncc_halfband_decim2(c2f_y, c2f_y, n / 2u);
+
+  int32_t max_lag_c = (max_lag + (int32_t)NCC_C2F_DECIM - 1) / (int32_t)NCC_C2F_DECIM;
+  doa_ncc_corr(c2f_x, c2f_y, nd, max_lag_c, c2f_corr);
+
+  // 粗峰间隔 >= 2 个粗 lag,各细搜索窗口互不重叠
+  doa_peak_t peaks[NCC_C2F_PEAKS];
+  uint32_t np = doa_corr_topk(c2f_corr, max_lag_c, NCC_C2F_PEAKS, 1, peaks);
+  if (np == 0u)
+  {
+    peaks[0].lag = doa_corr_argmax(c2f_corr, max_lag_c);
+    np = 1u;
+  }
+
+  for (int32_t i = 0; i < 2 * max_lag + 1; i++)
+    corr[i] = DOA_CORR_INVALID;
+
+  uint64_t ex = dsp_energy_q15(x, n);
+  uint64_t ey = dsp_energy_q15(y, n);
+  for (uint32_t p = 0; p < np; p++)
+  {
+    int32_t center = peaks[p].lag * (int32_t)NCC_C2F_DECIM;
+    int32_t lo = center - NCC_C2F_REFINE;
+    int32_t hi = center + NCC_C2F_REFINE;
+    if (lo < -max_lag)
+      lo = -max_lag;
+    if (hi > max_lag)
+      hi = max_lag;
+
+    for (int32_t lag = lo; lag <= hi; lag++)
+    {
+      corr[lag + max_lag] = ncc_score_lag(x, y, n, lag, ex, ey);
+    }
+  }
+}
+
+/**
+ * @brief 粗到细 NCC 估计 lag
+ */
+int32_t doa_estimate_lag_ncc_c2f(const int16_t *x, const int16_t *y, uint32_t n, int32_t max_lag)
+{
+  if (max_lag > DOA_CORR_MAX_LAG)
+    max_lag = DOA_CORR_MAX_LAG;
+
+  doa_ncc_corr_c2f(x, y, n, max_lag, ncc_corr);
+  return doa_corr_argmax(ncc_corr, max_lag);
+}
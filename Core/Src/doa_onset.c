@@ -0,0 +1,65 @@
+#include "doa_onset.h"
+#include <stdint.h>
+
+// 配置
+static uint32_t onset_window = 1u;
+static float onset_ratio = 4.0f;
+static float onset_alpha = 0.05f;
+
+// 能量包络(峰值保持 + 慢释放) / 当前窗口剩余帧数
+static float onset_env = 0.0f;
+static uint8_t onset_env_ready = 0;
+static uint32_t onset_left = 0;
+
+/**
+ * @brief 初始化
+ */
+void doa_onset_init(uint32_t window_frames, float ratio, float alpha)
+{
+  onset_window = (window_frames > 0u) ? window_frames : 1u;
+  onset_ratio = ratio;
+  onset_alpha = alpha;
+  onset_env = 0.0f;
+  onset_env_ready = 0;
+  onset_left = 0;
+}
+
+/**
+ * @brief 起振检测(优先效应)
+ * 能量比上一帧的包络高出 ratio 倍即判为起振,之后 window 帧内为直达声,
+ * 再往后直到能量跌破门限都当作混响尾部;尾部能量低于峰值保持的包络,不会重复触发
+ */
+uint8_t doa_onset_update(uint32_t energy, uint32_t th)
+{
+  float e = (float)energy;
+
+  if (!onset_env_ready)
+  {
+    onset_env = e;
+    onset_env_ready = 1;
+  }
+
+  // 包络: 上升立即跟随(峰值保持),下降按 alpha 缓慢释放
+  float prev = onset_env;
+  if (e > onset_env)
+    onset_env = e;
+  else
+    onset_env += onset_alpha * (e - onset_env);
+
+  if (energy <= th)
+  {
+    onset_left = 0;
+    return DOA_ONSET_IDLE;
+  }
+
+  // 静音后第一帧也算起振(包络还停在底噪)
+  if (e > onset_ratio * prev)
+    onset_left = onset_window;
+
+  if (onset_left > 0u)
+  {
+    onset_left--;
+    return DOA_ONSET_DIRECT;
+  }
+  return DOA_ONSET_TAIL;
+}
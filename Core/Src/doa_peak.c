@@ -0,0 +1,156 @@
+#include "doa_peak.h"
+#include <math.h>
+#include <stdint.h>
+
+/**
+ * @brief 相关峰位置(整数 lag)
+ */
+int32_t doa_corr_argmax(const float *corr, int32_t max_lag)
+{
+  float best = DOA_CORR_INVALID;
+  int32_t best_lag = 0;
+
+  for (int32_t lag = -max_lag; lag <= max_lag; lag++)
+  {
+    float r = corr[lag + max_lag];
+    if (r > best)
+    {
+      best = r;
+      best_lag = lag;
+    }
+  }
+
+  return best_lag;
+}
+
+/**
+ * @brief 主峰 + 次峰(单次扫描)
+ * 局部极大: 严格大于左邻、不小于右邻(平台取第一个点,与 doa_corr_argmax 一致)
+ */
+void doa_corr_peaks(const float *corr, int32_t max_lag, int32_t *peak_lag, float *peak, float *second)
+{
+  int32_t len = 2 * max_lag + 1;
+  float p1 = DOA_CORR_INVALID;
+  float p2 = DOA_CORR_INVALID;
+  int32_t i1 = max_lag;
+
+  for (int32_t i = 0; i < len; i++)
+  {
+    float r = corr[i];
+    float left = (i > 0) ? corr[i - 1] : DOA_CORR_INVALID;
+    float right = (i + 1 < len) ? corr[i + 1] : DOA_CORR_INVALID;
+
+    if (r <= DOA_CORR_INVALID || !(r > left && r >= right))
+      continue;
+
+    if (r > p1)
+    {
+      p2 = p1;
+      p1 = r;
+      i1 = i;
+    }
+    else if (r > p2)
+    {
+      p2 = r;
+    }
+  }
+
+  *peak_lag = i1 - max_lag;
+  *peak = p1;
+  *second = p2;
+}
+
+/**
+ * @brief 峰值三点插值(抛物线 / 高斯),边界或邻点无效时返回 0
+ */
+float doa_corr_interp(const float *corr, int32_t max_lag, int32_t lag)
+{
+  if (lag <= -max_lag || lag >= max_lag)
+    return 0.0f;
+
+  float ym = corr[lag + max_lag - 1];
+  float y0 = corr[lag + max_lag];
+  float yp = corr[lag + max_lag + 1];
+
+  if (ym <= DOA_CORR_INVALID || yp <= DOA_CORR_INVALID)
+    return 0.0f;
+
+#if (DOA_PEAK_INTERP == DOA_INTERP_GAUSSIAN)
+  // 高斯拟合要求三点为正,否则退回抛物线
+  if (ym > 0.0f && y0 > 0.0f && yp > 0.0f)
+  {
+    ym = logf(ym);
+    y0 = logf(y0);
+    yp = logf(yp);
+  }
+#endif
+
+  float den = ym - 2.0f * y0 + yp;
+  if (den >= 0.0f)
+    return 0.0f;
+
+  float d = 0.5f * (ym - yp) / den;
+
+  if (d > 0.5f)
+    d = 0.5f;
+  if (d < -0.5f)
+    d = -0.5f;
+  return d;
+}
+
+/**
+ * @brief Top-K 多峰提取
+ * 贪心 NMS: 每轮取未被抑制的最大局部极大,再抑制其 +-min_sep 内的点;
+ * 只读 corr,不改缓冲区,代价 O(k * (2*max_lag+1))
+ */
+uint32_t doa_corr_topk(const float *corr, int32_t max_lag, uint32_t k, int32_t min_sep, doa_peak_t *out)
+{
+  int32_t len = 2 * max_lag + 1;
+  uint32_t found = 0;
+
+  while (found < k)
+  {
+    float best = 0.0f;
+    int32_t best_i = -1;
+
+    for (int32_t i = 0; i < len; i++)
+    {
+      float r = corr[i];
+      float left = (i > 0) ? corr[i - 1] : DOA_CORR_INVALID;
+      float right = (i + 1 < len) ? corr[i + 1] : DOA_CORR_INVALID;
+
+      if (r <= best || !(r > left && r >= right))
+        continue;
+
+      // 已选峰附近的点被抑制
+      uint8_t suppressed = 0;
+      for (uint32_t j = 0; j < found; j++)
+      {
+        int32_t d = (i - max_lag) - out[j].lag;
+        if (d <= min_sep && d >= -min_sep)
+        {
+          suppressed = 1;
+          break;
+        }
+      }
+      if (suppressed)
+        continue;
+
+      best = r;
+      best_i = i;
+    }
+
+    if (best_i < 0)
+      break;
+
+    int32_t lag = best_i - max_lag;
+    float lag_f = ((float)lag + doa_corr_interp(corr, max_lag, lag)) * (float)DOA_Q16_ONE;
+
+    out[found].lag = lag;
+    out[found].lag_q16 = (int32_t)(lag_f + ((lag_f >= 0.0f) ? 0.5f : -0.5f));
+    out[found].score = best;
+    found++;
+  }
+
+  return found;
+}
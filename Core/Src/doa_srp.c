@@ -0,0 +1,168 @@
+#include "doa_srp.h"
+#include "doa_gcc_phat.h"
+#include "dsp_fft.h"
+#include <math.h>
+#include <stdint.h>
+
+#define SRP_PI 3.14159265358979f
+#define SRP_CORR_LEN (2 * SRP_MAX_LAG + 1)
+
+// 配置
+static doa_srp_cfg_t srp_cfg;
+static uint8_t srp_ready = 0;
+
+// 麦克风对
+static uint8_t srp_num_pairs = 0;
+static uint8_t srp_pair_i[SRP_MAX_PAIRS];
+static uint8_t srp_pair_j[SRP_MAX_PAIRS];
+static int32_t srp_pair_max_lag[SRP_MAX_PAIRS];
+
+// 查找表: 方位网格 -> 各对 lag(Q8 采样),初始化时算好,每帧不做三角函数
+static int16_t srp_lag_tab[SRP_MAX_PAIRS][SRP_MAX_GRID];
+
+// 各通道频谱 / 各对相关函数 / 功率
+static float srp_spec[SRP_MAX_MICS][SRP_MAX_NFFT];
+static float srp_work[SRP_MAX_NFFT];
+static float srp_corr[SRP_MAX_PAIRS][SRP_CORR_LEN];
+static float srp_power[SRP_MAX_GRID];
+
+/**
+ * @brief 初始化
+ */
+int doa_srp_init(const doa_srp_cfg_t *cfg)
+{
+  const doa_array_t *arr = cfg->array;
+
+  srp_ready = 0;
+  if (arr == 0 || arr->num_mics < 2u || arr->num_mics > SRP_MAX_MICS)
+    return -1;
+  if (cfg->grid_n == 0u || cfg->grid_n > SRP_MAX_GRID)
+    return -1;
+  if (fft_size_for(cfg->nfft) != cfg->nfft || cfg->nfft > SRP_MAX_NFFT)
+    return -1;
+
+  srp_cfg = *cfg;
+
+  srp_num_pairs = 0;
+  for (uint32_t i = 0; i < arr->num_mics; i++)
+  {
+    for (uint32_t j = i + 1u; j < arr->num_mics; j++)
+    {
+      srp_pair_i[srp_num_pairs] = (uint8_t)i;
+      srp_pair_j[srp_num_pairs] = (uint8_t)j;
+      srp_pair_max_lag[srp_num_pairs] = 0;
+      srp_num_pairs++;
+    }
+  }
+
+  // lag_ij = (tau_j - tau_i) * fs: x_j[t + lag] ~ x_i[t]
+  for (uint32_t g = 0; g < cfg->grid_n; g++)
+  {
+    float az = (cfg->az_start_deg + cfg->az_step_deg * (float)g) * (SRP_PI / 180.0f);
+    float s = sinf(az);
+    float c = cosf(az);
+
+    for (uint32_t p = 0; p < srp_num_pairs; p++)
+    {
+      float ti = doa_array_delay_s(arr, srp_pair_i[p], s, c);
+      float tj = doa_array_delay_s(arr, srp_pair_j[p], s, c);
+      float lag_f = (tj - ti) * cfg->fs_hz;
+
+      // 线性插值会用到 floor(lag) 和 floor(lag)+1
+      if (lag_f >= (float)(SRP_MAX_LAG - 1) || lag_f <= -(float)(SRP_MAX_LAG - 1))
+        return -1;
+
+      int32_t lag_q8 = (int32_t)floorf(lag_f * 256.0f + 0.5f);
+      srp_lag_tab[p][g] = (int16_t)lag_q8;
+
+      int32_t a = ((lag_q8 < 0) ? -lag_q8 : lag_q8) / 256 + 1;
+      if (a > srp_pair_max_lag[p])
+        srp_pair_max_lag[p] = a;
+    }
+  }
+
+  // 正负 lag 在循环相关里不能重叠
+  for (uint32_t p = 0; p < srp_num_pairs; p++)
+  {
+    if ((uint32_t)(2 * srp_pair_max_lag[p]) >= cfg->nfft)
+      return -1;
+  }
+
+  srp_ready = 1;
+  return 0;
+}
+
+/**
+ * @brief 每帧估计
+ * 每路只做一次正变换,每对一次 PHAT 加权 + 逆变换,之后全部是查表累加
+ */
+float doa_srp_estimate(const int16_t *const ch[], uint32_t n)
+{
+  if (!srp_ready)
+    return 0.0f;
+
+  uint32_t nfft = srp_cfg.nfft;
+  uint32_t nm = srp_cfg.array->num_mics;
+
+  if (n > nfft)
+    n = nfft;
+
+  for (uint32_t m = 0; m < nm; m++)
+  {
+    float *buf = srp_spec[m];
+    for (uint32_t i = 0; i < n; i++)
+      buf[i] = (float)ch[m][i];
+    for (uint32_t i = n; i < nfft; i++)
+      buf[i] = 0.0f;
+
+    fft_real_forward(buf, nfft);
+  }
+
+  // 各对 GCC-PHAT,只保留查找表会用到的 lag 范围
+  for (uint32_t p = 0; p < srp_num_pairs; p++)
+  {
+    int32_t ml = srp_pair_max_lag[p];
+
+    gcc_phat_cross(srp_spec[srp_pair_i[p]], srp_spec[srp_pair_j[p]], srp_work, nfft);
+    fft_real_inverse(srp_work, nfft);
+
+    for (int32_t lag = -ml; lag <= ml; lag++)
+    {
+      uint32_t idx = (lag < 0) ? (nfft - (uint32_t)(-lag)) : (uint32_t)lag;
+      srp_corr[p][lag + SRP_MAX_LAG] = srp_work[idx];
+    }
+  }
+
+  // 导向响应功率 = 各对相关函数在对应(分数)lag 处线性插值之和
+  uint32_t best_g = 0;
+  float best = -1e9f;
+  for (uint32_t g = 0; g < srp_cfg.grid_n; g++)
+  {
+    float acc = 0.0f;
+    for (uint32_t p = 0; p < srp_num_pairs; p++)
+    {
+      int32_t lag_q8 = srp_lag_tab[p][g];
+      int32_t base = lag_q8 >> 8;
+      float frac = (float)(lag_q8 & 0xFF) * (1.0f / 256.0f);
+      const float *r = &srp_corr[p][base + SRP_MAX_LAG];
+      acc += r[0] + frac * (r[1] - r[0]);
+    }
+
+    srp_power[g] = acc;
+    if (acc > best)
+    {
+      best = acc;
+      best_g = g;
+    }
+  }
+
+  return srp_cfg.az_start_deg + srp_cfg.az_step_deg * (float)best_g;
+}
+
+/**
+ * @brief 最近一次的导向响应功率
+ */
+const float *doa_srp_power(void)
+{
+  return srp_power;
+}
@@ -0,0 +1,175 @@
+#include "dsp_fft.h"
+#include <math.h>
+#include <stdint.h>
+
+#define FFT_PI 3.14159265358979f
+
+// 旋转因子表: cos/sin(2*pi*k/FFT_MAX_N), k < FFT_MAX_N/2
+static float fft_cos[FFT_MAX_N / 2u];
+static float fft_sin[FFT_MAX_N / 2u];
+static uint8_t fft_table_ready = 0;
+
+/**
+ * @brief 首次使用时生成旋转因子表(只算一次)
+ */
+static void fft_init_table(void)
+{
+  if (fft_table_ready)
+    return;
+
+  for (uint32_t k = 0; k < FFT_MAX_N / 2u; k++)
+  {
+    float a = 2.0f * FFT_PI * (float)k / (float)FFT_MAX_N;
+    fft_cos[k] = cosf(a);
+    fft_sin[k] = sinf(a);
+  }
+  fft_table_ready = 1;
+}
+
+/**
+ * @brief 复数 FFT(radix-2 DIT,原地,交错 re/im),逆变换不做缩放
+ */
+static void fft_complex(float *d, uint32_t m, uint8_t inverse)
+{
+  // 位反转重排
+  for (uint32_t i = 1, j = 0; i < m; i++)
+  {
+    uint32_t bit = m >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+
+    if (i < j)
+    {
+      float tr = d[2u * i];
+      float ti = d[2u * i + 1u];
+      d[2u * i] = d[2u * j];
+      d[2u * i + 1u] = d[2u * j + 1u];
+      d[2u * j] = tr;
+      d[2u * j + 1u] = ti;
+    }
+  }
+
+  // 蝶形运算:外层按旋转因子,内层按分组,减少查表
+  for (uint32_t len = 2u; len <= m; len <<= 1)
+  {
+    uint32_t half = len >> 1;
+    uint32_t step = FFT_MAX_N / len;
+
+    for (uint32_t k = 0; k < half; k++)
+    {
+      float wr = fft_cos[k * step];
+      float wi = inverse ? fft_sin[k * step] : -fft_sin[k * step];
+
+      for (uint32_t i = k; i < m; i += len)
+      {
+        float *a = &d[2u * i];
+        float *b = &d[2u * (i + half)];
+        float tr = b[0] * wr - b[1] * wi;
+        float ti = b[0] * wi + b[1] * wr;
+        b[0] = a[0] - tr;
+        b[1] = a[1] - ti;
+        a[0] += tr;
+        a[1] += ti;
+      }
+    }
+  }
+}
+
+/**
+ * @brief 不小于 n 的 2 的幂
+ */
+uint32_t fft_size_for(uint32_t n)
+{
+  uint32_t nfft = 4u;
+  while (nfft < n)
+    nfft <<= 1;
+  return (nfft <= FFT_MAX_N) ? nfft : 0u;
+}
+
+/**
+ * @brief 实数正变换: N 点实序列当作 N/2 点复序列做 FFT,再拆分
+ */
+void fft_real_forward(float *buf, uint32_t n)
+{
+  uint32_t m = n >> 1;
+  uint32_t step = FFT_MAX_N / n;
+
+  fft_init_table();
+  fft_complex(buf, m, 0);
+
+  // k=0 与 k=N/2 都是实数,打包到 buf[0]/buf[1]
+  float z0r = buf[0];
+  float z0i = buf[1];
+  buf[0] = z0r + z0i;
+  buf[1] = z0r - z0i;
+
+  for (uint32_t k = 1; k <= m / 2u; k++)
+  {
+    float *p = &buf[2u * k];
+    float *q = &buf[2u * (m - k)];
+
+    // Fe = (Z[k] + conj(Z[m-k])) / 2, Fo = -i (Z[k] - conj(Z[m-k])) / 2
+    float fer = 0.5f * (p[0] + q[0]);
+    float fei = 0.5f * (p[1] - q[1]);
+    float for_ = 0.5f * (p[1] + q[1]);
+    float foi = -0.5f * (p[0] - q[0]);
+
+    // t = W^k * Fo, W = exp(-2*pi*i/N)
+    float wr = fft_cos[k * step];
+    float wi = -fft_sin[k * step];
+    float tr = for_ * wr - foi * wi;
+    float ti = for_ * wi + foi * wr;
+
+    // X[k] = Fe + t, X[m-k] = conj(Fe - t)
+    p[0] = fer + tr;
+    p[1] = fei + ti;
+    q[0] = fer - tr;
+    q[1] = ti - fei;
+  }
+}
+
+/**
+ * @brief 实数逆变换(含 1/N 缩放),输入为 fft_real_forward 的打包格式
+ */
+void fft_real_inverse(float *buf, uint32_t n)
+{
+  uint32_t m = n >> 1;
+  uint32_t step = FFT_MAX_N / n;
+
+  fft_init_table();
+
+  float x0 = buf[0];
+  float xm = buf[1];
+  buf[0] = 0.5f * (x0 + xm);
+  buf[1] = 0.5f * (x0 - xm);
+
+  for (uint32_t k = 1; k <= m / 2u; k++)
+  {
+    float *p = &buf[2u * k];
+    float *q = &buf[2u * (m - k)];
+
+    // Fe = (X[k] + conj(X[m-k])) / 2, Fo = (X[k] - conj(X[m-k])) / 2 * W^-k
+    float fer = 0.5f * (p[0] + q[0]);
+    float fei = 0.5f * (p[1] - q[1]);
+    float dr = 0.5f * (p[0] - q[0]);
+    float di = 0.5f * (p[1] + q[1]);
+
+    float wr = fft_cos[k * step];
+    float wi = fft_sin[k * step];
+    float for_ = dr * wr - di * wi;
+    float foi = dr * wi + di * wr;
+
+    // Z[k] = Fe + i*Fo, Z[m-k] = conj(Fe) + i*conj(Fo)
+    p[0] = fer - foi;
+    p[1] = fei + for_;
+    q[0] = fer + foi;
+    q[1] = for_ - fei;
+  }
+
+  fft_complex(buf, m, 1);
+
+  float scale = 1.0f / (float)m;
+  for (uint32_t i = 0; i < n; i++)
+    buf[i] *= scale;
+}
@@ -0,0 +1,93 @@
+#include "dsp_xcorr.h"
+#include <stdint.h>
+#include <string.h>
+
+// 双 MAC 内核开关: 默认随目标 DSP 扩展,主机测试可 -DDSP_XCORR_USE_SIMD=1 强制走模拟指令
+#ifndef DSP_XCORR_USE_SIMD
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define DSP_XCORR_USE_SIMD 1
+#else
+#define DSP_XCORR_USE_SIMD 0
+#endif
+#endif
+
+#if DSP_XCORR_USE_SIMD
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "main.h"
+#else
+/**
+ * @brief 主机模拟 SMLALD: sum + lo(x)*lo(y) + hi(x)*hi(y),有符号 16bit 乘,64bit 回绕累加
+ */
+static inline uint64_t __SMLALD(uint32_t x, uint32_t y, uint64_t sum)
+{
+  int32_t lo = (int32_t)(int16_t)(x & 0xFFFFu) * (int32_t)(int16_t)(y & 0xFFFFu);
+  int32_t hi = (int32_t)(int16_t)(x >> 16) * (int32_t)(int16_t)(y >> 16);
+  return sum + (uint64_t)(int64_t)lo + (uint64_t)(int64_t)hi;
+}
+#endif
+#endif
+
+/**
+ * @brief 纯 C 参考点积
+ */
+int64_t dsp_dot_q15_ref(const int16_t *a, const int16_t *b, uint32_t len)
+{
+  int64_t acc = 0;
+  for (uint32_t i = 0; i < len; i++)
+  {
+    acc += (int64_t)((int32_t)a[i] * (int32_t)b[i]);
+  }
+  return acc;
+}
+
+#if DSP_XCORR_USE_SIMD
+/**
+ * @brief 读两个相邻 int16 打包成 32bit(允许半字对齐,M4 支持非对齐 LDR)
+ */
+static inline uint32_t read_q15x2(const int16_t *p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/**
+ * @brief SMLALD 点积: 每条指令两次 16x16 MAC,循环展开 4 个采样
+ */
+int64_t dsp_dot_q15(const int16_t *a, const int16_t *b, uint32_t len)
+{
+  uint64_t acc = 0;
+  uint32_t blk = len >> 2;
+
+  while (blk--)
+  {
+    acc = __SMLALD(read_q15x2(a), read_q15x2(b), acc);
+    acc = __SMLALD(read_q15x2(a + 2), read_q15x2(b + 2), acc);
+    a += 4;
+    b += 4;
+  }
+
+  int64_t sum = (int64_t)acc;
+  for (uint32_t i = 0; i < (len & 3u); i++)
+  {
+    sum += (int64_t)((int32_t)a[i] * (int32_t)b[i]);
+  }
+  return sum;
+}
+#else
+/**
+ * @brief 无 DSP 扩展时退回参考实现
+ */
+int64_t dsp_dot_q15(const int16_t *a, const int16_t *b, uint32_t len)
+{
+  return dsp_dot_q15_ref(a, b, len);
+}
+#endif
+
+/**
+ * @brief 能量 = 自身点积(非负)
+ */
+uint64_t dsp_energy_q15(const int16_t *a, uint32_t len)
+{
+  return (uint64_t)dsp_dot_q15(a, a, len);
+}
@@ -20,6 +20,9 @@ int main(void)
   MX_GPIO_Init();
   MX_DMA_Init();
   MX_ADC1_Init();
+#if AUDIO_CAPTURE_DUAL_ADC
+  MX_ADC2_Init();
+#endif
   MX_USART1_UART_Init();
   MX_TIM2_Init();
   MX_TIM3_Init();
@@ -1,4 +1,5 @@
 #include "servo.h"
+#include "doa_angle.h"
 #include "tim.h"
 #include "main.h"
 #include <stdint.h>
@@ -57,22 +58,40 @@ void servo_write_us(int us)
  * valid=0 时不更新(保持)
  */
 void servo_track_from_lag(int32_t lag, uint8_t valid)
+{
+    servo_track_from_lag_q16(lag * 65536, valid);
+}
+
+/**
+ * @brief 亚采样 lag(Q16.16) -> 方位角 -> 舵机 PWM
+ * valid=0 时不更新(保持)
+ */
+void servo_track_from_lag_q16(int32_t lag_q16, uint8_t valid)
 {
     if (!valid)
         return;
 
     // 物理限幅(防误峰)
-    if (lag > MAX_LAG_SAMPLES)
-        lag = MAX_LAG_SAMPLES;
-    if (lag < -MAX_LAG_SAMPLES)
-        lag = -MAX_LAG_SAMPLES;
+    lag_q16 = clamp_int(lag_q16, -MAX_LAG_SAMPLES * 65536, MAX_LAG_SAMPLES * 65536);
 
     // 死区
-    if (lag >= -LAG_DEADBAND && lag <= LAG_DEADBAND)
-        lag = 0;
+    if (lag_q16 >= -LAG_DEADBAND_Q16 && lag_q16 <= LAG_DEADBAND_Q16)
+        lag_q16 = 0;
+
+    servo_track_from_angle(doa_angle_from_lag_q16(lag_q16), 1u);
+}
+
+/**
+ * @brief 方位角(0.01 度) -> 舵机 PWM(角度线性映射 + 滤波)
+ * 方位角为正(偏 mic1 一侧)时脉宽减小,与原 lag 映射方向一致
+ * valid=0 时不更新(保持)
+ */
+void servo_track_from_angle(int32_t angle_cdeg, uint8_t valid)
+{
+    if (!valid)
+        return;
 
-    // 满量程映射:中心 + lag*K
-    float target = (float)SERVO_US_CENTER + (float)lag * SERVO_K_US_PER_LAG;
+    float target = (float)SERVO_US_CENTER - (float)angle_cdeg * (0.01f * SERVO_US_PER_DEG);
     target = clamp_f(target, (float)SERVO_US_MIN, (float)SERVO_US_MAX);
 
     // 一阶低通滤波
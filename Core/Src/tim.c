@@ -1,4 +1,5 @@
 #include "tim.h"
+#include "app.h"
 
 volatile uint32_t g_tim3_pwm_msp_called = 0;
 
@@ -13,7 +14,7 @@ void MX_TIM2_Init(void)
   htim2.Instance = TIM2;
   htim2.Init.Prescaler = 0;
   htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
-  htim2.Init.Period = 1749;
+  htim2.Init.Period = ADC_TRIG_PERIOD;
   htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
   htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
   if (HAL_TIM_Base_Init(&htim2) != HAL_OK)
@@ -3,28 +3,90 @@
 
 UART_HandleTypeDef huart1;
 
-// 重定向printf到串口
+// 命令接收: 单字节中断,遇到 \r/\n 结束一行
+static uint8_t uart_rx_byte;
+static char uart_line[UART_CMD_MAX];
+static volatile uint8_t uart_line_len = 0;
+static volatile uint8_t uart_line_ready = 0;
+
+// 发送环形缓冲: printf 只拷贝进环,中断逐段发出,主循环不等 UART(115200 波特约 87us/字节)
+static uint8_t uart_tx_buf[UART_TX_BUF_SIZE];
+static volatile uint32_t uart_tx_head = 0; // 下一个写入位置(主循环)
+static volatile uint32_t uart_tx_tail = 0; // 正在/下一个发送位置(中断)
+static volatile uint32_t uart_tx_len = 0;  // 正在发送的字节数(0 = 空闲)
+static volatile uint32_t uart_tx_drops = 0;
+
+/**
+ * @brief 空闲且环中有数据时发出一段连续数据(到环尾为止)
+ * 在 USART1 中断里或屏蔽 USART1 中断时调用
+ */
+static void uart_tx_kick(void)
+{
+  uint32_t head = uart_tx_head;
+  uint32_t tail = uart_tx_tail;
+  if (uart_tx_len != 0u || head == tail)
+    return;
+
+  uint32_t n = (head > tail) ? (head - tail) : (UART_TX_BUF_SIZE - tail);
+  uart_tx_len = n;
+
+  // 串口尚未初始化等: 不挂起,下次写入再试
+  if (HAL_UART_Transmit_IT(&huart1, &uart_tx_buf[tail], (uint16_t)n) != HAL_OK)
+    uart_tx_len = 0;
+}
+
+// 重定向printf到串口: 非阻塞,环里放不下整段时整段丢弃并计数(不输出半行)
 int _write(int file, char *ptr, int len)
 {
   (void)file; // 消除未使用参数警告
-  
-  // 等待上一次传输完成
-  while (huart1.gState != HAL_UART_STATE_READY)
+
+  if (len <= 0)
+    return 0;
+
+  uint32_t head = uart_tx_head;
+  uint32_t used = (head - uart_tx_tail + UART_TX_BUF_SIZE) % UART_TX_BUF_SIZE;
+  if ((uint32_t)len > UART_TX_BUF_SIZE - 1u - used)
   {
-    // 等待
+    uart_tx_drops += (uint32_t)len;
+    return len;
   }
-  
-  HAL_UART_Transmit_IT(&huart1, (uint8_t *)ptr, len);
-  
-  // 等待本次传输完成
-  while (huart1.gState != HAL_UART_STATE_READY)
+
+  for (int i = 0; i < len; i++)
   {
-    // 等待
+    uart_tx_buf[head] = (uint8_t)ptr[i];
+    head = (head + 1u) % UART_TX_BUF_SIZE;
   }
-  
+  uart_tx_head = head;
+
+  // 与发送完成中断互斥(HAL 句柄锁 / uart_tx_len)
+  HAL_NVIC_DisableIRQ(USART1_IRQn);
+  uart_tx_kick();
+  HAL_NVIC_EnableIRQ(USART1_IRQn);
+
   return len;
 }
 
+/**
+ * @brief 发送完成回调: 释放已发出的一段,接着发下一段
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == USART1)
+  {
+    uart_tx_tail = (uart_tx_tail + uart_tx_len) % UART_TX_BUF_SIZE;
+    uart_tx_len = 0;
+    uart_tx_kick();
+  }
+}
+
+/**
+ * @brief 因发送环满而丢弃的字节数(累计)
+ */
+uint32_t uart_tx_dropped(void)
+{
+  return uart_tx_drops;
+}
+
 void MX_USART1_UART_Init(void)
 {
   huart1.Instance = USART1;
@@ -74,3 +136,58 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef *uartHandle)
     HAL_NVIC_DisableIRQ(USART1_IRQn);
   }
 }
+
+/**
+ * @brief 启动命令接收
+ */
+void uart_cmd_start(void)
+{
+  HAL_UART_Receive_IT(&huart1, &uart_rx_byte, 1);
+}
+
+/**
+ * @brief 接收完成回调: 拼行(上一行未取走时丢弃新字符)
+ */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == USART1)
+  {
+    char c = (char)uart_rx_byte;
+
+    if (!uart_line_ready)
+    {
+      if (c == '\r' || c == '\n')
+      {
+        if (uart_line_len > 0u)
+        {
+          uart_line[uart_line_len] = '\0';
+          uart_line_ready = 1;
+        }
+      }
+      else if (uart_line_len < UART_CMD_MAX - 1u)
+      {
+        uart_line[uart_line_len++] = c;
+      }
+    }
+
+    HAL_UART_Receive_IT(&huart1, &uart_rx_byte, 1);
+  }
+}
+
+/**
+ * @brief 取一行命令,有则拷贝到 line 并返回 1
+ */
+uint8_t uart_cmd_poll(char *line, uint32_t size)
+{
+  if (!uart_line_ready || size == 0u)
+    return 0;
+
+  uint32_t i = 0;
+  for (; i + 1u < size && i < uart_line_len; i++)
+    line[i] = uart_line[i];
+  line[i] = '\0';
+
+  uart_line_len = 0;
+  uart_line_ready = 0;
+  return 1;
+}
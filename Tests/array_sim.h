@@ -0,0 +1,121 @@
+#ifndef __ARRAY_SIM_H
+#define __ARRAY_SIM_H
+
+#include "test_common.h"
+#include "doa_array.h"
+#include <time.h>
+
+// 阵列仿真: 多个正弦叠加的宽带源,按平面波时延解析地生成各麦克风信号(分数时延无插值误差)
+#define SIM_TONES 48u
+#define SIM_PI 3.14159265358979
+
+typedef struct
+{
+  double f[SIM_TONES];
+  double ph[SIM_TONES];
+  double amp;
+} sim_source_t;
+
+/**
+ * @brief 随机生成 [f_lo, f_hi] 内的宽带源(每帧重新抽相位,模拟非平稳信号)
+ */
+static inline void sim_source_random(sim_source_t *s, double f_lo, double f_hi, double amp)
+{
+  for (uint32_t k = 0; k < SIM_TONES; k++)
+  {
+    s->f[k] = f_lo + (f_hi - f_lo) * (double)(test_rand_u32() >> 8) / 16777216.0;
+    s->ph[k] = 2.0 * SIM_PI * (double)(test_rand_u32() >> 8) / 16777216.0;
+  }
+  s->amp = amp / sqrt((double)SIM_TONES / 2.0);
+}
+
+/**
+ * @brief 方位 az_deg 的源到达阵列各麦克风(加独立噪声),ch[m] 长度 n
+ */
+static inline void sim_array_frame(const doa_array_t *arr, const sim_source_t *s, double az_deg,
+                                   double fs, float noise, int16_t *const ch[], uint32_t n)
+{
+  double az = az_deg * SIM_PI / 180.0;
+  for (uint32_t m = 0; m < arr->num_mics; m++)
+  {
+    double tau = doa_array_delay_s(arr, m, (float)sin(az), (float)cos(az));
+    for (uint32_t i = 0; i < n; i++)
+    {
+      double t = (double)i / fs - tau;
+      double v = 0.0;
+      for (uint32_t k = 0; k < SIM_TONES; k++)
+        v += cos(2.0 * SIM_PI * s->f[k] * t + s->ph[k]);
+      ch[m][i] = test_sat16((float)(s->amp * v) + noise * test_gauss());
+    }
+  }
+}
+
+// 圆周角差(度)
+static inline double sim_az_err(double a, double b)
+{
+  double d = fmod(fabs(a - b), 360.0);
+  return (d > 180.0) ? 360.0 - d : d;
+}
+
+// 主机计时(微秒)
+static inline double sim_now_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec * 1e-3;
+}
+
+// 被测阵列引擎: 每个方位先 init,连续喂 frames 帧,从第 settle 帧起逐帧计误差
+typedef struct
+{
+  const char *name;
+  const doa_array_t *array;
+  int (*init)(void);
+  float (*frame)(const int16_t *const ch[], uint32_t n); // 喂一帧并返回方位估计(度)
+  double f_lo_hz;                                        // 仿真声源频段
+  double f_hi_hz;
+  uint32_t frames;
+  uint32_t settle;
+} sim_engine_t;
+
+/**
+ * @brief 方位扫描: 每个方位独立收敛/估计,超出 tol_deg 计为失败;打印最大误差与主机耗时,返回最大误差(度)
+ * 主机耗时仅作相对参考,目标板上的周期由固件 "music on" / "srp on" 的 DWT 读数给出
+ */
+static inline double sim_sweep(const sim_engine_t *e, double fs, uint32_t n, int16_t *const ch[], const double *az,
+                               uint32_t n_az, double tol_deg)
+{
+  double worst = 0.0;
+  double t_us = 0.0;
+  uint32_t calls = 0;
+  sim_source_t src;
+
+  for (uint32_t a = 0; a < n_az; a++)
+  {
+    TEST_CHECK(e->init() == 0, "%s: init", e->name);
+
+    for (uint32_t f = 0; f < e->frames; f++)
+    {
+      sim_source_random(&src, e->f_lo_hz, e->f_hi_hz, 3000.0);
+      sim_array_frame(e->array, &src, az[a], fs, 300.0f, ch, n);
+
+      double t0 = sim_now_us();
+      float est = e->frame((const int16_t *const *)ch, n);
+      t_us += sim_now_us() - t0;
+      calls++;
+
+      if (f < e->settle)
+        continue;
+      double err = sim_az_err(est, az[a]);
+      TEST_CHECK(err <= tol_deg, "%s: az=%.1f est=%.1f", e->name, az[a], (double)est);
+      if (err > worst)
+        worst = err;
+    }
+  }
+
+  printf("%s: max err %.1f deg (tol %.1f), host %.1f us/frame (frame period %.0f us)\n", e->name, worst, tol_deg,
+         t_us / (double)calls, 1e6 * (double)n / fs);
+  return worst;
+}
+
+#endif /* __ARRAY_SIM_H */
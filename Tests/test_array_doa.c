@@ -0,0 +1,84 @@
+/*
+ * 阵列引擎(MUSIC / SRP-PHAT)离线精度与吞吐: 4 麦方阵 360 度扫描,以及当前硬件的 2 麦线阵
+ * (与固件 "music on" / "srp on" 相同配置)
+ */
+#include "array_sim.h"
+#include "doa_music.h"
+#include "doa_srp.h"
+
+#define FS 48000.0
+#define FRAME_N 512u
+
+static int16_t buf[DOA_ARRAY_MAX_MICS][FRAME_N];
+static int16_t *const ch[DOA_ARRAY_MAX_MICS] = {buf[0], buf[1], buf[2], buf[3]};
+
+// 4 麦方阵: MUSIC 用边长 6cm,SRP 用 10cm(各自的空间混叠/分辨率折中)
+static const doa_array_t square6 = {4u, {{-0.03f, -0.03f}, {0.03f, -0.03f}, {0.03f, 0.03f}, {-0.03f, 0.03f}}};
+static const doa_array_t square10 = {4u, {{-0.05f, -0.05f}, {0.05f, -0.05f}, {0.05f, 0.05f}, {-0.05f, 0.05f}}};
+static const doa_array_t pair = DOA_ARRAY_INIT_2MIC;
+
+static const doa_music_cfg_t music_cfg4 = {&square6, (float)FS, FRAME_N, 500.0f, 2500.0f, 8u, 1u, 0.7f, 0.0f, 5.0f, 72u};
+static const doa_music_cfg_t music_cfg2 = {&pair, (float)FS, FRAME_N, 500.0f, 1400.0f, 8u, 1u, 0.7f, -90.0f, 2.5f, 73u};
+static const doa_srp_cfg_t srp_cfg4 = {&square10, (float)FS, 1024u, 0.0f, 5.0f, 72u};
+static const doa_srp_cfg_t srp_cfg2 = {&pair, (float)FS, 1024u, -88.75f, 2.5f, 72u};
+
+static const doa_music_cfg_t *music_cur;
+static const doa_srp_cfg_t *srp_cur;
+
+static int music_init(void)
+{
+  return doa_music_init(music_cur);
+}
+
+// MUSIC: 协方差逐帧递推,每帧都估计(只有收敛后的帧计误差)
+static float music_frame(const int16_t *const c[], uint32_t n)
+{
+  doa_music_update(c, n);
+  return doa_music_estimate();
+}
+
+static int srp_init(void)
+{
+  return doa_srp_init(srp_cur);
+}
+
+// SRP-PHAT: 单帧估计
+static float srp_frame(const int16_t *const c[], uint32_t n)
+{
+  return doa_srp_estimate(c, n);
+}
+
+int main(void)
+{
+  // 方阵: 5..341 度,步长 24 度;线阵: 避开端射方向
+  double az4[15];
+  for (uint32_t i = 0; i < 15u; i++)
+    az4[i] = 24.0 * (double)i + 5.0;
+  static const double az2_music[] = {-60.0, -35.0, -10.0, 0.0, 20.0, 45.0, 70.0};
+  static const double az2_srp[] = {-60.0, -35.0, -10.0, 0.0, 20.0, 45.0, 60.0};
+
+  // MUSIC: 每个方位 8 帧,最后一帧(协方差已收敛)计误差
+  test_seed(2024u);
+  sim_engine_t music = {"music square4", &square6, music_init, music_frame, 500.0, 2500.0, 8u, 7u};
+  music_cur = &music_cfg4;
+  sim_sweep(&music, FS, FRAME_N, ch, az4, 15u, 2.0);
+
+  music.name = "music pair2";
+  music.array = &pair;
+  music.f_hi_hz = 1400.0;
+  music_cur = &music_cfg2;
+  sim_sweep(&music, FS, FRAME_N, ch, az2_music, sizeof(az2_music) / sizeof(az2_music[0]), 2.5);
+
+  // SRP-PHAT: 宽带源(PHAT 白化后整带等权),每个方位 4 个独立帧都计误差
+  test_seed(4242u);
+  sim_engine_t srp = {"srp square4", &square10, srp_init, srp_frame, 300.0, 10000.0, 4u, 0u};
+  srp_cur = &srp_cfg4;
+  sim_sweep(&srp, FS, FRAME_N, ch, az4, 15u, 3.0);
+
+  srp.name = "srp pair2";
+  srp.array = &pair;
+  srp_cur = &srp_cfg2;
+  sim_sweep(&srp, FS, FRAME_N, ch, az2_srp, sizeof(az2_srp) / sizeof(az2_srp[0]), 3.8);
+
+  return test_failures;
+}
@@ -0,0 +1,97 @@
+#ifndef __TEST_COMMON_H
+#define __TEST_COMMON_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// 失败计数,main 返回它(ctest 以非 0 判失败)
+static int test_failures = 0;
+
+#define TEST_CHECK(cond, ...)                            \
+  do                                                     \
+  {                                                      \
+    if (!(cond))                                         \
+    {                                                    \
+      test_failures++;                                   \
+      printf("FAIL %s:%d: ", __FILE__, __LINE__);        \
+      printf(__VA_ARGS__);                               \
+      printf("\n");                                      \
+    }                                                    \
+  } while (0)
+
+// 可复现的伪随机数(与主机 libc 无关)
+static uint32_t test_rng = 1u;
+
+static inline void test_seed(uint32_t s)
+{
+  test_rng = s ? s : 1u;
+}
+
+static inline uint32_t test_rand_u32(void)
+{
+  test_rng ^= test_rng << 13;
+  test_rng ^= test_rng >> 17;
+  test_rng ^= test_rng << 5;
+  return test_rng;
+}
+
+// 近似高斯(12 个均匀数求和),方差 1
+static inline float test_gauss(void)
+{
+  float s = 0.0f;
+  for (int i = 0; i < 12; i++)
+    s += (float)(test_rand_u32() >> 8) * (1.0f / 16777216.0f);
+  return s - 6.0f;
+}
+
+static inline int16_t test_sat16(float v)
+{
+  if (v > 32767.0f)
+    return 32767;
+  if (v < -32768.0f)
+    return -32768;
+  return (int16_t)lrintf(v);
+}
+
+/**
+ * @brief 生成一对整数延迟的宽带噪声帧: y[i + lag] ~ x[i]
+ * amp: 信号幅度(标准差), noise: 两路独立噪声幅度; src 长度 >= n + 2 * |lag| + 2
+ */
+static inline void test_delayed_pair(int16_t *x, int16_t *y, uint32_t n, int32_t lag,
+                                     float amp, float noise, float *src, uint32_t src_len)
+{
+  for (uint32_t i = 0; i < src_len; i++)
+    src[i] = amp * test_gauss();
+
+  uint32_t off = src_len / 2u - n / 2u;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    x[i] = test_sat16(src[off + i] + noise * test_gauss());
+    y[i] = test_sat16(src[(int32_t)(off + i) - lag] + noise * test_gauss());
+  }
+}
+
+/**
+ * @brief 两个独立声源叠加: 源 1 延迟 lag1,源 2 延迟 lag2,幅度 amp1 / amp2
+ * src1 / src2 长度 src_len >= n + 2 * max(|lag|) + 2
+ */
+static inline void test_two_source_pair(int16_t *x, int16_t *y, uint32_t n, int32_t lag1, int32_t lag2,
+                                        float amp1, float amp2, float noise,
+                                        float *src1, float *src2, uint32_t src_len)
+{
+  for (uint32_t i = 0; i < src_len; i++)
+  {
+    src1[i] = amp1 * test_gauss();
+    src2[i] = amp2 * test_gauss();
+  }
+
+  uint32_t off = src_len / 2u - n / 2u;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    x[i] = test_sat16(src1[off + i] + src2[off + i] + noise * test_gauss());
+    y[i] = test_sat16(src1[(int32_t)(off + i) - lag1] + src2[(int32_t)(off + i) - lag2] + noise * test_gauss());
+  }
+}
+
+#endif /* __TEST_COMMON_H */
@@ -0,0 +1,43 @@
+/*
+ * lag -> 方位角查表: 与 asin 直接计算一致;未显式 doa_angle_init 时首次调用也正确
+ */
+#include "test_common.h"
+#include "doa_angle.h"
+#include "doa_array.h"
+
+int main(void)
+{
+  // 首次调用前不调用 doa_angle_init
+  int32_t first = doa_angle_from_lag_q16(4 * 65536);
+  double k = (double)SOUND_SPEED_MPS / ((double)FS_HZ * (double)MIC_DIST_M);
+  double want_first = asin(-4.0 * k) * 18000.0 / 3.14159265358979;
+  TEST_CHECK(fabs((double)first - want_first) <= 2.0, "use before init: %d vs %.1f", (int)first, want_first);
+
+  // |az| <= 80 度内查表 + 线性插值误差(0.01 度);靠近端射方向 asin 斜率发散,只检查饱和
+  double max_err = 0.0;
+  for (int32_t q = -MAX_LAG_SAMPLES * 65536; q <= MAX_LAG_SAMPLES * 65536; q += 997)
+  {
+    double s = -(double)q / 65536.0 * k;
+    if (s > 1.0)
+      s = 1.0;
+    if (s < -1.0)
+      s = -1.0;
+    double want = asin(s) * 18000.0 / 3.14159265358979;
+    if (fabs(want) > 8000.0)
+      continue;
+
+    double err = fabs((double)doa_angle_from_lag_q16(q) - want);
+    if (err > max_err)
+      max_err = err;
+  }
+  printf("max |err| within +-80 deg: %.2f cdeg\n", max_err);
+  TEST_CHECK(max_err <= 5.0, "table error %.2f cdeg", max_err);
+
+  // 超出 +-MAX_LAG_SAMPLES 饱和到表端
+  int32_t end_pos = doa_angle_from_lag_q16(MAX_LAG_SAMPLES * 65536);
+  int32_t end_neg = doa_angle_from_lag_q16(-MAX_LAG_SAMPLES * 65536);
+  TEST_CHECK(doa_angle_from_lag_q16(1000 * 65536) == end_pos, "positive overflow not saturated");
+  TEST_CHECK(doa_angle_from_lag_q16(-1000 * 65536) == end_neg, "negative overflow not saturated");
+
+  return test_failures;
+}
@@ -0,0 +1,47 @@
+/*
+ * lag 直方图: 无声帧也衰减时,声源停止一段时间后新方向第一帧即可接管众数;
+ * 不衰减时旧方向一直占着众数
+ */
+#include "test_common.h"
+#include "doa_hist.h"
+
+#define MAX_LAG 16
+#define DECAY 0.95f
+
+/**
+ * @brief 旧声源 lag 5 持续 talk 帧,静音 quiet 帧(decay_quiet 决定是否按帧衰减),新声源 lag -8 一帧
+ */
+static int32_t run(uint32_t quiet, int decay_quiet)
+{
+  (void)doa_hist_init(MAX_LAG, DECAY);
+  for (uint32_t f = 0; f < 100u; f++)
+    doa_hist_update(5 * 65536, 0.6f);
+  for (uint32_t f = 0; f < quiet && decay_quiet; f++)
+    doa_hist_update(0, 0.0f);
+  doa_hist_update(-8 * 65536, 0.3f);
+  return doa_hist_mode_q16();
+}
+
+int main(void)
+{
+  // 48kHz 帧移 256: 1 秒静音约 188 帧
+  int32_t with_decay = run(188u, 1);
+  int32_t without_decay = run(188u, 0);
+  printf("mode after 1 s silence: decayed %.2f, frozen %.2f\n", (double)with_decay / 65536.0,
+         (double)without_decay / 65536.0);
+
+  TEST_CHECK(with_decay > -9 * 65536 && with_decay < -7 * 65536, "new talker not taken over: %.2f",
+             (double)with_decay / 65536.0);
+  TEST_CHECK(without_decay > 4 * 65536 && without_decay < 6 * 65536, "reference case changed: %.2f",
+             (double)without_decay / 65536.0);
+
+  // 静音帧不改变众数本身(衰减等比例)
+  (void)doa_hist_init(MAX_LAG, DECAY);
+  doa_hist_update(3 * 65536, 0.5f);
+  int32_t before = doa_hist_mode_q16();
+  for (uint32_t f = 0; f < 50u; f++)
+    doa_hist_update(0, 0.0f);
+  TEST_CHECK(doa_hist_mode_q16() == before, "decay-only frames moved the mode");
+
+  return test_failures;
+}
@@ -0,0 +1,114 @@
+/*
+ * 各后端的置信度/峰旁瓣比: 单声源帧可信,两个相当声源的帧不可信;
+ * 粗到细 NCC 与全 lag NCC 给出一致的判断(不会因旁瓣未精算而虚高),top-K 找到两个声源。
+ * 48kHz (512 / +-16) 与高采样率 (1024 / +-84,AUDIO_HIGH_RATE 下 c2f 为默认后端) 两组配置
+ */
+#include "test_common.h"
+#include "doa.h"
+
+#define MAX_N 1024u
+#define SRC_LEN (MAX_N + 256u)
+#define FRAMES 40u
+
+// 与 app.h 中 DOA_CONF_TH 相同的门限
+#define CONF_TH 0.15f
+
+static int16_t x[MAX_N];
+static int16_t y[MAX_N];
+static float src1[SRC_LEN];
+static float src2[SRC_LEN];
+
+static const uint32_t backends[] = {DOA_BACKEND_NCC, DOA_BACKEND_NCC_C2F, DOA_BACKEND_GCC_PHAT};
+#define NUM_BACKENDS (sizeof(backends) / sizeof(backends[0]))
+
+/**
+ * @brief 两路同一个一阶低通(线性时不变,等效于对声源滤波):
+ * 高采样率下麦克风/前端带宽只占奈奎斯特频率的一小部分
+ */
+static void lowpass_pair(uint32_t n, float a)
+{
+  float sx = x[0];
+  float sy = y[0];
+  for (uint32_t i = 0; i < n; i++)
+  {
+    sx += a * ((float)x[i] - sx);
+    sy += a * ((float)y[i] - sy);
+    x[i] = test_sat16(sx);
+    y[i] = test_sat16(sy);
+  }
+}
+
+/**
+ * @brief 一组帧长/lag 范围: 单声源 lag_single,两个相当声源 lag1 / lag2;lp > 0 时两路低通
+ */
+static void check_config(uint32_t n, int32_t max_lag, int32_t lag_single, int32_t lag1, int32_t lag2, float lp)
+{
+  uint32_t pass_single[NUM_BACKENDS] = {0};
+  uint32_t pass_dual[NUM_BACKENDS] = {0};
+  float psr_dual[NUM_BACKENDS] = {0};
+  uint32_t both_found[NUM_BACKENDS] = {0};
+
+  for (uint32_t f = 0; f < FRAMES; f++)
+  {
+    test_two_source_pair(x, y, n, lag_single, 0, 3000.0f, 0.0f, 600.0f, src1, src2, SRC_LEN);
+    if (lp > 0.0f)
+      lowpass_pair(n, lp);
+    for (uint32_t b = 0; b < NUM_BACKENDS; b++)
+    {
+      doa_result_t res;
+      (void)doa_backend_select(backends[b]);
+      doa_estimate(x, y, n, max_lag, &res);
+      TEST_CHECK(res.lag == lag_single, "%u/%d %s single: lag=%d", (unsigned)n, (int)max_lag,
+                 doa_backend_get(backends[b])->name, (int)res.lag);
+      pass_single[b] += (res.confidence >= CONF_TH);
+    }
+
+    test_two_source_pair(x, y, n, lag1, lag2, 3000.0f, 3000.0f, 300.0f, src1, src2, SRC_LEN);
+    if (lp > 0.0f)
+      lowpass_pair(n, lp);
+    for (uint32_t b = 0; b < NUM_BACKENDS; b++)
+    {
+      doa_result_t res;
+      (void)doa_backend_select(backends[b]);
+      doa_estimate(x, y, n, max_lag, &res);
+      pass_dual[b] += (res.confidence >= CONF_TH);
+      psr_dual[b] += res.psr / (float)FRAMES;
+
+      // 同一相关函数上的前两个峰应恰为两个声源
+      doa_peak_t peaks[2];
+      uint32_t np = doa_last_topk(peaks, 2u);
+      int found1 = 0;
+      int found2 = 0;
+      for (uint32_t p = 0; p < np; p++)
+      {
+        found1 |= (peaks[p].lag == lag1);
+        found2 |= (peaks[p].lag == lag2);
+      }
+      both_found[b] += (found1 && found2);
+    }
+  }
+
+  for (uint32_t b = 0; b < NUM_BACKENDS; b++)
+  {
+    const char *name = doa_backend_get(backends[b])->name;
+    printf("%4u/+-%-3d %-9s single: %2u/%u pass | dual: %2u/%u pass, mean psr %.2f, top-2 = {%d, %d} %2u/%u\n",
+           (unsigned)n, (int)max_lag, name, (unsigned)pass_single[b], (unsigned)FRAMES, (unsigned)pass_dual[b],
+           (unsigned)FRAMES, (double)psr_dual[b], (int)lag1, (int)lag2, (unsigned)both_found[b], (unsigned)FRAMES);
+
+    // 单声源几乎全部通过,两个相当声源几乎全部被拦下
+    TEST_CHECK(pass_single[b] >= FRAMES * 9u / 10u, "%s: single-source frames gated", name);
+    TEST_CHECK(pass_dual[b] <= FRAMES / 10u, "%s: dual-source frames pass the gate", name);
+    TEST_CHECK(both_found[b] >= FRAMES * 9u / 10u, "%s: top-2 misses one of the talkers", name);
+  }
+}
+
+int main(void)
+{
+  test_seed(31337u);
+  doa_init();
+
+  check_config(512u, 16, 5, 6, -9, 0.0f);
+  check_config(1024u, 84, 40, 30, -45, 0.4f);
+
+  return test_failures;
+}
@@ -0,0 +1,77 @@
+/*
+ * GCC-PHAT 与 NCC 对照: 延迟宽带噪声帧上两者 lag 一致且等于真值
+ * 按高采样率配置编译(FFT_MAX_N = 2048),两种帧长都不截断
+ */
+#include "test_common.h"
+#include "doa_gcc_phat.h"
+#include "doa_ncc.h"
+
+#define N_MAX 1024u
+#define SRC_LEN (N_MAX + 256u)
+
+static int16_t x[N_MAX];
+static int16_t y[N_MAX];
+static float src[SRC_LEN];
+
+/**
+ * @brief 一组 (帧长, lag 范围) 上逐 lag 对照
+ */
+static void check_range(uint32_t n, int32_t max_lag, int32_t step, uint32_t frames)
+{
+  uint32_t agree = 0;
+  uint32_t total = 0;
+
+  for (int32_t lag = -max_lag; lag <= max_lag; lag += step)
+  {
+    for (uint32_t f = 0; f < frames; f++)
+    {
+      test_delayed_pair(x, y, n, lag, 2000.0f, 600.0f, src, SRC_LEN);
+
+      int32_t l_gcc = doa_estimate_lag_gcc_phat(x, y, n, max_lag);
+      int32_t l_ncc = doa_estimate_lag_ncc(x, y, n, max_lag);
+      TEST_CHECK(l_gcc == lag, "n=%u lag=%d: gcc=%d", (unsigned)n, (int)lag, (int)l_gcc);
+      TEST_CHECK(l_ncc == lag, "n=%u lag=%d: ncc=%d", (unsigned)n, (int)lag, (int)l_ncc);
+
+      agree += (l_gcc == l_ncc);
+      total++;
+    }
+  }
+
+  printf("n=%u max_lag=%d: gcc == ncc on %u/%u frames\n", (unsigned)n, (int)max_lag,
+         (unsigned)agree, (unsigned)total);
+}
+
+/**
+ * @brief 只有最后 max_lag 个采样有声的帧(小 lag,重叠足够): FFT 容纳不下 n + max_lag
+ * 而截掉帧尾时 GCC 看不到信号
+ */
+static void check_tail(uint32_t n, int32_t max_lag)
+{
+  uint32_t tail = (uint32_t)max_lag;
+  for (int32_t lag = -20; lag <= 20; lag += 5)
+  {
+    test_delayed_pair(x, y, n, lag, 2000.0f, 0.0f, src, SRC_LEN);
+    for (uint32_t i = 0; i < n - tail; i++)
+    {
+      x[i] = 0;
+      y[i] = 0;
+    }
+
+    int32_t l_gcc = doa_estimate_lag_gcc_phat(x, y, n, max_lag);
+    TEST_CHECK(l_gcc == lag, "tail n=%u lag=%d: gcc=%d", (unsigned)n, (int)lag, (int)l_gcc);
+  }
+}
+
+int main(void)
+{
+  test_seed(12345u);
+
+  // 48kHz 配置: 512 点, +-16
+  check_range(512u, 16, 1, 8u);
+
+  // 240kHz 配置: 1024 点, +-84
+  check_range(1024u, 84, 7, 4u);
+  check_tail(1024u, 84);
+
+  return test_failures;
+}
@@ -0,0 +1,104 @@
+/*
+ * 粗到细 NCC 与全 lag NCC 是否选同一个整数峰: 遍历全部 lag / 幅度 / 噪声,
+ * 按噪声档打印失配率. 粗搜索只看 /4 抽取后的低频段,只保留 NCC_C2F_PEAKS 个候选,
+ * 低信噪比或宽带声源(高采样率下高频能量被抽取丢掉)时可能错过全搜索的峰
+ */
+#include "test_common.h"
+#include "doa_ncc.h"
+
+#define MAX_N 1024u
+#define SRC_LEN (MAX_N + 256u)
+
+#define N_AMPS 3u
+#define N_NOISE 5u
+
+static const float amps[N_AMPS] = {3000.0f, 300.0f, 30.0f};
+static const float noise_ratio[N_NOISE] = {0.0f, 0.3f, 1.0f, 2.0f, 4.0f}; // 噪声 / 信号幅度
+
+static int16_t x[MAX_N];
+static int16_t y[MAX_N];
+static float src[SRC_LEN];
+
+/**
+ * @brief 两路同一个一阶低通(等效于对声源滤波)
+ */
+static void lowpass_pair(uint32_t n, float a)
+{
+  float sx = x[0];
+  float sy = y[0];
+  for (uint32_t i = 0; i < n; i++)
+  {
+    sx += a * ((float)x[i] - sx);
+    sy += a * ((float)y[i] - sy);
+    x[i] = test_sat16(sx);
+    y[i] = test_sat16(sy);
+  }
+}
+
+/**
+ * @brief 一组配置逐帧比较两种搜索的整数峰
+ * @param max_miss 每个噪声档允许的最大失配率,噪声 <= 信号时必须完全一致
+ */
+static void check_config(const char *name, uint32_t n, int32_t max_lag, float lp, uint32_t reps,
+                         const float max_miss[N_NOISE])
+{
+  uint32_t frames = 0;
+  uint32_t miss_total = 0;
+
+  for (uint32_t k = 0; k < N_NOISE; k++)
+  {
+    uint32_t cnt = 0;
+    uint32_t miss = 0;
+    uint32_t ok_ncc = 0;
+    uint32_t ok_c2f = 0;
+
+    for (int32_t lag = -max_lag; lag <= max_lag; lag++)
+    {
+      for (uint32_t a = 0; a < N_AMPS; a++)
+      {
+        for (uint32_t r = 0; r < reps; r++)
+        {
+          test_delayed_pair(x, y, n, lag, amps[a], noise_ratio[k] * amps[a], src, SRC_LEN);
+          if (lp > 0.0f)
+            lowpass_pair(n, lp);
+
+          int32_t l_full = doa_estimate_lag_ncc(x, y, n, max_lag);
+          int32_t l_c2f = doa_estimate_lag_ncc_c2f(x, y, n, max_lag);
+          miss += (l_full != l_c2f);
+          ok_ncc += (l_full == lag);
+          ok_c2f += (l_c2f == lag);
+          cnt++;
+        }
+      }
+    }
+
+    float rate = (float)miss / (float)cnt;
+    printf("%s noise %.1fx: c2f != ncc %u/%u (%.2f%%), correct lag ncc %u c2f %u\n", name,
+           (double)noise_ratio[k], (unsigned)miss, (unsigned)cnt, 100.0 * rate, (unsigned)ok_ncc,
+           (unsigned)ok_c2f);
+    TEST_CHECK(rate <= max_miss[k], "%s noise %.1fx: mismatch %.4f > %.4f", name, (double)noise_ratio[k],
+               (double)rate, (double)max_miss[k]);
+
+    frames += cnt;
+    miss_total += miss;
+  }
+
+  printf("%s total: c2f != ncc %u/%u (%.2f%%)\n", name, (unsigned)miss_total, (unsigned)frames,
+         100.0 * (double)miss_total / (double)frames);
+}
+
+int main(void)
+{
+  test_seed(777u);
+
+  // 失配上限取实测值(8.6 / 28.5%, 7.6 / 9.1%, 9.9 / 52%)留余量,c2f 变差时测试会失败
+  static const float miss_48k[N_NOISE] = {0.0f, 0.0f, 0.0f, 0.12f, 0.35f};
+  static const float miss_lp[N_NOISE] = {0.0f, 0.0f, 0.0f, 0.12f, 0.15f};
+  static const float miss_wide[N_NOISE] = {0.0f, 0.0f, 0.0f, 0.15f, 0.60f};
+
+  check_config("512/+-16", 512u, 16, 0.0f, 4u, miss_48k);
+  check_config("1024/+-84 lowpass", 1024u, 84, 0.4f, 2u, miss_lp);
+  check_config("1024/+-84 wideband", 1024u, 84, 0.0f, 2u, miss_wide);
+
+  return test_failures;
+}
@@ -0,0 +1,110 @@
+/*
+ * 定点 NCC 与浮点 NCC 在合成语料上结果一致:
+ * doa_estimate_lag_ncc_q 选同一个峰;ncc_q 后端的峰/插值/次峰/top-K 与 ncc 后端逐位相同
+ */
+#include "test_common.h"
+#include "doa.h"
+#include "doa_ncc.h"
+
+#define MAX_N 1024u
+#define SRC_LEN (MAX_N + 256u)
+
+static int16_t x[MAX_N];
+static int16_t y[MAX_N];
+static float src[SRC_LEN];
+
+// 对比的多峰个数
+#define DOA_TOPK_CHECK 3u
+
+static uint32_t frames = 0;
+
+/**
+ * @brief 一帧上对比两条路径
+ */
+static void check_frame(uint32_t n, int32_t max_lag, int32_t lag)
+{
+  int32_t l_f = doa_estimate_lag_ncc(x, y, n, max_lag);
+  int32_t l_q = doa_estimate_lag_ncc_q(x, y, n, max_lag);
+  TEST_CHECK(l_f == l_q, "n=%u lag=%d: ncc=%d ncc_q=%d", (unsigned)n, (int)lag, (int)l_f, (int)l_q);
+
+  doa_result_t rf;
+  doa_result_t rq;
+  doa_peak_t pf[DOA_TOPK_CHECK];
+  doa_peak_t pq[DOA_TOPK_CHECK];
+
+  (void)doa_backend_select(DOA_BACKEND_NCC);
+  doa_estimate(x, y, n, max_lag, &rf);
+  uint32_t kf = doa_last_topk(pf, DOA_TOPK_CHECK);
+
+  (void)doa_backend_select(DOA_BACKEND_NCC_Q);
+  doa_estimate(x, y, n, max_lag, &rq);
+  uint32_t kq = doa_last_topk(pq, DOA_TOPK_CHECK);
+
+  TEST_CHECK(rf.lag == rq.lag && rf.lag_q16 == rq.lag_q16, "n=%u lag=%d: lag %d/%d q16 %d/%d", (unsigned)n, (int)lag,
+             (int)rf.lag, (int)rq.lag, (int)rf.lag_q16, (int)rq.lag_q16);
+  TEST_CHECK(rf.peak == rq.peak && rf.second == rq.second, "n=%u lag=%d: peak %f/%f second %f/%f", (unsigned)n,
+             (int)lag, (double)rf.peak, (double)rq.peak, (double)rf.second, (double)rq.second);
+  TEST_CHECK(kf == kq, "n=%u lag=%d: top-k count %u/%u", (unsigned)n, (int)lag, (unsigned)kf, (unsigned)kq);
+  for (uint32_t i = 0; i < kf && i < kq; i++)
+  {
+    TEST_CHECK(pf[i].lag_q16 == pq[i].lag_q16 && pf[i].score == pq[i].score, "n=%u lag=%d: top-k[%u] differs",
+               (unsigned)n, (int)lag, (unsigned)i);
+  }
+  frames++;
+}
+
+/**
+ * @brief 一组帧长/lag 范围: 各 lag、不同信噪比/幅度(含两路增益失配、接近静音)
+ */
+static void check_range(uint32_t n, int32_t max_lag, int32_t step)
+{
+  static const float amps[] = {3000.0f, 300.0f, 20.0f};
+  static const float noises[] = {0.0f, 300.0f, 3000.0f};
+
+  for (int32_t lag = -max_lag; lag <= max_lag; lag += step)
+  {
+    for (uint32_t a = 0; a < sizeof(amps) / sizeof(amps[0]); a++)
+    {
+      for (uint32_t k = 0; k < sizeof(noises) / sizeof(noises[0]); k++)
+      {
+        test_delayed_pair(x, y, n, lag, amps[a], noises[k] * amps[a] / 3000.0f, src, SRC_LEN);
+        check_frame(n, max_lag, lag);
+
+        // AGC 增益失配: 一路缩小 8 倍
+        for (uint32_t i = 0; i < n; i++)
+          y[i] = (int16_t)(y[i] / 8);
+        check_frame(n, max_lag, lag);
+      }
+    }
+  }
+
+  // 两个声源叠加(多峰)
+  for (uint32_t f = 0; f < 20u; f++)
+  {
+    int32_t l1 = (int32_t)(test_rand_u32() % (uint32_t)(2 * max_lag + 1)) - max_lag;
+    int32_t l2 = (int32_t)(test_rand_u32() % (uint32_t)(2 * max_lag + 1)) - max_lag;
+    static float src2[SRC_LEN];
+    test_two_source_pair(x, y, n, l1, l2, 3000.0f, 2000.0f, 300.0f, src, src2, SRC_LEN);
+    check_frame(n, max_lag, l1);
+  }
+
+  // 全零帧: 两路都退回 lag 0
+  for (uint32_t i = 0; i < n; i++)
+  {
+    x[i] = 0;
+    y[i] = 0;
+  }
+  check_frame(n, max_lag, 0);
+}
+
+int main(void)
+{
+  test_seed(4242u);
+  doa_init();
+
+  check_range(512u, 16, 1);
+  check_range(1024u, 84, 3);
+
+  printf("ncc_q == ncc on %u frames\n", (unsigned)frames);
+  return test_failures;
+}
@@ -0,0 +1,90 @@
+/*
+ * 相位斜率模式: GCC 后端顺带用本帧频谱求亚采样 lag,比三点插值更准;
+ * 非 GCC 后端不受影响(不会取到上一帧的斜率)
+ */
+#include "array_sim.h"
+#include "doa.h"
+#include "doa_gcc_phat.h"
+
+#define FRAME_N 512u
+#define MAX_LAG 16
+#define FS 48000.0
+#define FRAMES_PER_AZ 4u
+
+static int16_t x[FRAME_N];
+static int16_t y[FRAME_N];
+
+int main(void)
+{
+  test_seed(2024u);
+  doa_init();
+
+  const doa_array_t arr = DOA_ARRAY_INIT_2MIC;
+  int16_t *const ch[2] = {x, y};
+  sim_source_t src;
+
+  double err_interp = 0.0;
+  double err_slope = 0.0;
+  uint32_t frames = 0;
+  uint32_t outliers = 0;
+
+  for (double az = -60.0; az <= 60.0; az += 5.0)
+  {
+    // y[i + lag] ~ x[i]: lag = (tau_1 - tau_0) * fs
+    double s = sin(az * SIM_PI / 180.0);
+    double c = cos(az * SIM_PI / 180.0);
+    double truth = (doa_array_delay_s(&arr, 1u, (float)s, (float)c) - doa_array_delay_s(&arr, 0u, (float)s, (float)c)) * FS;
+
+    for (uint32_t f = 0; f < FRAMES_PER_AZ; f++)
+    {
+      // 宽带源(PHAT 白化后各频点等权,整带都要有信号);斜率只用空间混叠频率 c/(2d) 以下的频点
+      sim_source_random(&src, 300.0, 10000.0, 3000.0);
+      sim_array_frame(&arr, &src, az, FS, 100.0f, ch, FRAME_N);
+
+      doa_result_t r0;
+      doa_result_t r1;
+      (void)doa_backend_select(DOA_BACKEND_GCC_PHAT);
+
+      doa_gcc_set_phase_slope(0);
+      doa_estimate(x, y, FRAME_N, MAX_LAG, &r0);
+      TEST_CHECK(doa_gcc_take_slope(0, 0) != 0, "slope result while mode is off");
+
+      doa_gcc_set_phase_slope(1);
+      doa_estimate(x, y, FRAME_N, MAX_LAG, &r1);
+      TEST_CHECK(r0.lag == r1.lag && r0.peak == r1.peak, "az=%.1f: slope mode changed the integer peak", az);
+
+      // 模式开着切到 NCC: 结果与模式关闭时相同
+      doa_result_t rn0;
+      doa_result_t rn1;
+      (void)doa_backend_select(DOA_BACKEND_NCC);
+      doa_estimate(x, y, FRAME_N, MAX_LAG, &rn1);
+      doa_gcc_set_phase_slope(0);
+      doa_estimate(x, y, FRAME_N, MAX_LAG, &rn0);
+      TEST_CHECK(rn0.lag_q16 == rn1.lag_q16, "az=%.1f: ncc picked up a gcc phase slope", az);
+
+      // 整数峰选错的帧斜率模式不接手(偏离超过 1 个采样),只统计整数峰正确的帧
+      if (fabs((double)r0.lag - truth) > 1.0)
+      {
+        outliers++;
+        continue;
+      }
+      double e0 = fabs((double)r0.lag_q16 / DOA_Q16_ONE - truth);
+      double e1 = fabs((double)r1.lag_q16 / DOA_Q16_ONE - truth);
+      err_interp += e0;
+      err_slope += e1;
+
+      frames++;
+    }
+  }
+
+  err_interp /= (double)frames;
+  err_slope /= (double)frames;
+  printf("mean |lag err| (samples) over %u frames (%u outliers): interp %.3f, slope %.3f\n", (unsigned)frames,
+         (unsigned)outliers, err_interp, err_slope);
+
+  TEST_CHECK(err_slope < 0.8 * err_interp, "phase slope (%.3f) not better than interpolation (%.3f)", err_slope,
+             err_interp);
+  TEST_CHECK(outliers * 10u <= frames, "too many wrong integer peaks: %u", (unsigned)outliers);
+
+  return test_failures;
+}